@@ -96,4 +96,3 @@ void loop()
   ledMatrix.show(); // Update the chip with the new framebuffer
   delay(500);
 }
-* */
\ No newline at end of file
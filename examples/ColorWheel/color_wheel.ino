@@ -19,6 +19,7 @@
 //   - show()              : push the framebuffer to the chip in one burst.
 //   - setGlobalCurrent()  : set the master brightness (current) once at start.
 //   - setScaling()        : set the white balance once at start.
+//   - setOutputLut()      : gamma-correct the output with a compile-time table.
 //
 // It is also the simplest place to SEE the difference between the three
 // brightness stages of the chip: global current (master), per-channel scaling
@@ -116,6 +117,10 @@ void setup()
   // 3. Set Scaling (White Balance) to maximum
   // This ensures that when you set PWM to maximum, the LED will shine at full brightness.
   ledMatrix.setScaling(0xFF, 0xFF, 0xFF);
+
+  // 4. Gamma-correct the output (applied while show() streams the bytes), so
+  // the linear hueToRgb() ramps look even instead of washed out.
+  ledMatrix.setOutputLut(AwColorLut<>::table);
 }
 
 //*********************************************************** */
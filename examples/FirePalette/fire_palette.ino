@@ -167,6 +167,9 @@ void setup()
   // 3. Set Scaling (White Balance) to maximum.
   ledMatrix.setScaling(0xFF, 0xFF, 0xFF);
 
+  // Gamma 2.2 on output: the dark end of the heat palette keeps its reds.
+  ledMatrix.setOutputLut(AwColorLut<>::table);
+
   // 4. Seed the random generator and start with a cold (black) field.
   randomSeed((uint32_t)analogRead(SEED_NOISE_PIN) ^ micros());
   memset(heat, 0, sizeof(heat));
@@ -22,9 +22,10 @@
 // to the engines while leaving the rest under direct PWM control.
 //
 // You will practice:
-//   - setChannelPattern(x, y, ch, pat) : route one color channel of one pixel
-//     to a breathing engine (PATx) or to direct PWM. (setPixelPatternRGB() is
-//     just the shortcut that routes all three channels at once.)
+//   - setPatternRect(x, y, w, h, rPat, gPat, bPat) + commitPatterns() : route
+//     the color channels of a whole block of pixels to breathing engines (PATx)
+//     or to direct PWM, sent to the chip in one burst. (setChannelPattern()
+//     routes a single channel of a single pixel immediately.)
 //   - configureBreathing() + setBreathingBrightness() + startBreathing() to set
 //     up and launch the autonomous engines.
 //   - the key idea: PAT-routed channels follow the engine with ZERO MCU load,
@@ -116,28 +117,18 @@ void setup()
   ledMatrix.setBreathingBrightness(AwPattern::PAT1, 0x00, 0x60); // G
   ledMatrix.setBreathingBrightness(AwPattern::PAT2, 0x00, 0x10); // B
 
-  // 4. Route the channels of every pixel.
-  for (uint8_t y = 0; y < HEIGHT_LED_MATIX; y++)
-  {
-    for (uint8_t x = 0; x < WIDTH_LED_MATRIX; x++)
-    {
-      if (y < SPLIT_ROW)
-      {
-        // Top band: bind each color channel to its breathing engine.
-        // (This is exactly what setPixelPatternRGB(x, y, PAT0, PAT1, PAT2)
-        //  does; we use setChannelPattern here to show the per-channel call.)
-        ledMatrix.setChannelPattern(x, y, AwChannel::R, AwPattern::PAT0);
-        ledMatrix.setChannelPattern(x, y, AwChannel::G, AwPattern::PAT1);
-        ledMatrix.setChannelPattern(x, y, AwChannel::B, AwPattern::PAT2);
-      }
-      else
-      {
-        // Bottom band: keep all channels under direct PWM control so the MCU
-        // can animate them with setPixel()/show().
-        ledMatrix.setPixelPatternRGB(x, y, AwPattern::PWM, AwPattern::PWM, AwPattern::PWM);
-      }
-    }
-  }
+  // 4. Route the channels of every pixel. The bulk calls only edit a RAM copy
+  //    of Page 3; commitPatterns() then sends it to the chip in one burst.
+  //    (setChannelPattern(x, y, ch, pat) does the same for a single channel,
+  //    written to the chip immediately.)
+  //    Top band: bind each color channel to its breathing engine.
+  ledMatrix.setPatternRect(0, 0, WIDTH_LED_MATRIX, SPLIT_ROW,
+                           AwPattern::PAT0, AwPattern::PAT1, AwPattern::PAT2);
+  //    Bottom band: keep all channels under direct PWM control so the MCU can
+  //    animate them with setPixel()/show().
+  ledMatrix.setPatternRect(0, SPLIT_ROW, WIDTH_LED_MATRIX, HEIGHT_LED_MATIX - SPLIT_ROW,
+                           AwPattern::PWM, AwPattern::PWM, AwPattern::PWM);
+  ledMatrix.commitPatterns();
 
   // 5. Start the autonomous breathing engines. From now on the top band runs
   //    with no MCU involvement at all.
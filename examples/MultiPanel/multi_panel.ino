@@ -18,21 +18,30 @@
 //
 //   - create more than one AW20216S object on the same `SPI` bus, each with its
 //     own CS pin.
-//   - wrap them behind world-coordinate helpers (setPixelWorld / showAll) so
-//     the rest of your drawing code ignores where the panel boundary is.
+//   - place them in an AW20216SArray, which owns one world framebuffer, so the
+//     rest of your drawing code ignores where the panel boundary is.
 //
 // You will practice:
-//   - instantiating multiple drivers and calling begin() on each.
-//   - mapping a wide logical coordinate to the right panel + local coordinate.
-//   - pushing both framebuffers each frame.
+//   - addPanel() with each panel's world position (and, if a panel is mounted
+//     turned or mirrored, its AwRotation / mirror flag).
+//   - drawing in world coordinates with wall.setPixel().
+//   - wall.showAll(): both chips are updated back-to-back in one SPI
+//     transaction, and a panel whose region did not change is skipped.
+//
+// AVR boards (Uno, Leonardo): the wall's world framebuffer costs another
+// 432 bytes on top of the two drivers, which does not fit in 2 KB of SRAM.
+// There the sketch skips AW20216SArray and routes each world pixel to its
+// panel by hand (setPixelWorld() below): same picture, one show() per panel.
 //
 // Wiring: panel A and panel B share SCK (18), MOSI (23) and MISO (19). Panel A
 // CS -> GPIO 5, panel B CS -> GPIO 15. Both share GND with the ESP32; power the
-// LEDs from an external supply.
+// LEDs from an external supply. On an Uno use the hardware SPI pins (SCK 13,
+// MOSI 11, MISO 12) and any two free pins for CS.
 
 #include <Arduino.h>
 #include <SPI.h>
 #include "AW20216S.h"
+#include "AW20216SArray.h"
 
 //*********************************************************** */
 //***********        Definitions                              */
@@ -60,10 +69,22 @@
 #define HUE_SPAN  18  // Hue change per canvas column (spreads the rainbow).
 #define FRAME_MS  30  // Milliseconds between frames.
 
+// The world framebuffer does not fit next to two drivers on AVR.
+#if defined(ARDUINO_ARCH_AVR)
+#define USE_WALL  0
+#else
+#define USE_WALL  1
+#endif
+
 // Two drivers on the SAME SPI bus, each with its own CS pin.
 AW20216S panelA(PANEL_H, PANEL_W, CS_PIN_A, SPI);
 AW20216S panelB(PANEL_H, PANEL_W, CS_PIN_B, SPI);
 
+#if USE_WALL
+// One canvas (wx = 0..CANVAS_W-1, wy = 0..CANVAS_H-1) covering both panels.
+AW20216SArray<CANVAS_W, CANVAS_H, PANELS_X> wall;
+#endif
+
 //*********************************************************** */
 //***********        Multi-panel helpers                      */
 //*********************************************************** */
@@ -73,24 +94,36 @@ AW20216S panelB(PANEL_H, PANEL_W, CS_PIN_B, SPI);
 // Plot a pixel in world coordinates, routing it to the correct panel.
 static void setPixelWorld(uint8_t wx, uint8_t wy, uint8_t r, uint8_t g, uint8_t b)
 {
+#if USE_WALL
+  wall.setPixel(wx, wy, r, g, b);
+#else
   if (wx < PANEL_W)
     panelA.setPixel(wx, wy, r, g, b);            // left panel
   else
     panelB.setPixel(wx - PANEL_W, wy, r, g, b);  // right panel (local x)
+#endif
 }
 
-// Clear both framebuffers.
+// Clear the whole canvas.
 static void clearAll()
 {
+#if USE_WALL
+  wall.clearScreen();
+#else
   panelA.clearScreen();
   panelB.clearScreen();
+#endif
 }
 
-// Push both framebuffers to their chips.
+// Push the canvas to both chips.
 static void showAll()
 {
+#if USE_WALL
+  wall.showAll();
+#else
   panelA.show();
   panelB.show();
+#endif
 }
 
 //*********************************************************** */
@@ -118,10 +151,19 @@ void setup()
   Serial.begin(115200);
   Serial.println("Starting AW20216S MultiPanel...");
   delay(500);
+#if defined(ARDUINO_ARCH_AVR)
+  SPI.begin();
+#else
   SPI.begin(PIN_SCK, PIN_MISO, PIN_MOSI, CS_PIN_A);
+#endif
   delay(50);
 
-  // Initialize both panels. They share the bus but answer on different CS pins.
+  // Place the panels side by side in the world, then initialize both. They
+  // share the bus but answer on different CS pins.
+#if USE_WALL
+  wall.addPanel(panelA, 0, 0);
+  wall.addPanel(panelB, PANEL_W, 0);
+#endif
   const bool okA = panelA.begin();
   const bool okB = panelB.begin();
   Serial.print("Panel A (CS ");
@@ -8,8 +8,8 @@
 // dim white test image and prints a report over Serial that:
 //   1. Checks communication (reads GCR and compares it to the expected value).
 //   2. Dumps the key Page 0 configuration registers in hex and binary.
-//   3. Dumps the Open/Short detection registers (OSR, 0x03..0x26) and flags any
-//      non-zero byte as a possible open/short fault.
+//   3. Dumps the Open/Short detection registers (OSR, 0x03..0x26) in one burst
+//      read, then runs scanFaults() and lists every open/short LED by (x, y).
 //   4. Runs a write+read round-trip test to confirm both directions work.
 // The report repeats every few seconds, so you can wiggle wiring or swap the
 // panel and watch the values change live.
@@ -22,17 +22,18 @@
 //
 // You will practice:
 //   - readRegister(page, reg)  : read any register on any page.
+//   - readRegisters(page, ...) : read a block of registers in one SPI frame.
 //   - writeRegister(page, reg) : write any register (used for the round-trip).
+//   - scanFaults(map)          : open/short detection decoded per LED.
 //   - interpreting GCR / GCCR / PCCR and the OSR fault registers.
 //
 // Honest notes about this chip:
 //   - There is no readable "chip ID" register. The reliable "is it alive?" test
 //     is reading GCR: begin() leaves it at 0xB1, so a correct read-back proves
 //     the SPI link (MOSI, MISO, SCK, CS) is wired right.
-//   - The exact LED <-> bit mapping of the OSR registers is datasheet-specific
-//     and not decoded by this library, so we report the raw bytes and which
-//     register holds a fault, not an (x, y) pixel. Open/short detection may also
-//     need to be enabled/triggered per the datasheet to populate these bytes.
+//   - The OSR registers only hold results while detection is enabled in GCR,
+//     and only for LEDs the chip is driving. scanFaults() enables it, waits,
+//     reads and restores GCR; the test image below keeps every LED lit.
 
 #include <Arduino.h>
 #include <SPI.h>
@@ -56,9 +57,8 @@
 // Value begin() leaves in GCR (CHIPEN + 12 active rows). Used as the link test.
 #define GCR_EXPECTED 0xB1
 
-// Open/Short register block on Page 0 (inclusive range).
-#define OSR_START 0x03
-#define OSR_END   0x26
+// Open/Short register block on Page 0 (0x03..0x26).
+#define OSR_COUNT AW_OSR_REGS
 
 // How often the report is reprinted.
 #define REPORT_MS 5000
@@ -149,28 +149,49 @@ static void dumpConfig()
   }
 }
 
-// 3) Dump the Open/Short registers and flag any non-zero byte.
+// 3) Dump the raw Open/Short registers, then scan and list faulty LEDs.
 static void dumpOpenShort()
 {
+  // One burst read of the whole block (values as left by the last scan).
+  uint8_t osr[OSR_COUNT];
+  ledMatrix.readRegisters(AW20216S_PAGE0, AW_REG_OSR_BASE, osr, OSR_COUNT);
+
   Serial.println("Open/Short registers (0x03..0x26):");
-  uint8_t faults = 0;
+  for (uint8_t i = 0; i < OSR_COUNT; i++)
+  {
+    Serial.print(i % 6 == 0 ? "  " : " ");
+    printHex8(osr[i]);
+    if (i % 6 == 5)
+      Serial.println();
+  }
+
+  // Detection pass: open + short, decoded to (x, y, channel).
+  AwFaultMap map;
+  const uint16_t faults = ledMatrix.scanFaults(map);
+  static const char CH[3] = {'R', 'G', 'B'};
 
-  for (uint8_t reg = OSR_START; reg <= OSR_END; reg++)
+  for (uint8_t y = 0; y < HEIGHT_LED_MATIX; y++)
   {
-    const uint8_t v = ledMatrix.readRegister(AW20216S_PAGE0, reg);
-    if (v != 0x00)
+    for (uint8_t x = 0; x < WIDTH_LED_MATRIX; x++)
     {
-      faults++;
-      Serial.print("  FAULT at ");
-      printHex8(reg);
-      Serial.print(" = ");
-      printBin8(v);
-      Serial.println("  (a set bit = an open/short LED; see datasheet for mapping)");
+      for (uint8_t c = 0; c < 3; c++)
+      {
+        const AwChannel ch = (AwChannel)c;
+        if (!map.isOpen(x, y, ch) && !map.isShort(x, y, ch))
+          continue;
+        Serial.print("  FAULT x=");
+        Serial.print(x);
+        Serial.print(" y=");
+        Serial.print(y);
+        Serial.print(" ");
+        Serial.print(CH[c]);
+        Serial.println(map.isOpen(x, y, ch) ? "  open" : "  short");
+      }
     }
   }
 
   if (faults == 0)
-    Serial.println("  All zero -> no open/short reported.");
+    Serial.println("  scanFaults(): no open/short LED found.");
 }
 
 // 4) Write+read round-trip on GCCR to prove both directions work, then restore.
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "AW20216S.h"
+#include "AW20216SFrameLoop.h"
 
 //*********************************************************** */
 //***********        Definitions                              */
@@ -78,6 +79,15 @@ static const uint8_t kOffR = 0;
 static const uint8_t kOffG = 85;   // ~120 degrees
 static const uint8_t kOffB = 170;  // ~240 degrees
 
+// -------------------- Frame pacing --------------------
+#define FRAME_FPS      50  // Target frame rate.
+#define REPORT_FRAMES 250  // Print frame-time statistics every N frames (5 s).
+
+static void renderFrame(uint32_t frame, void *ctx);
+
+// Calls renderFrame() and ledMatrix.show() on a fixed 50 fps grid.
+AW20216SFrameLoop frameLoop(ledMatrix, renderFrame);
+
 //*********************************************************** */
 //***********        Setup Function                           */
 //*********************************************************** */
@@ -96,8 +106,11 @@ void setup()
 
   ledMatrix.setGlobalCurrent(0x40);
   ledMatrix.setScaling(0xFF, 0xFF, 0xFF);
+  ledMatrix.setOutputLut(AwColorLut<>::table); // gamma 2.2: smoother sine ramps
   ledMatrix.clearScreen();
   ledMatrix.show();
+
+  frameLoop.begin(FRAME_FPS);
 }
 
 //*********************************************************** */
@@ -106,14 +119,20 @@ void setup()
 
 void loop()
 {
-  static uint32_t lastMs = 0;
-  static uint8_t t = 0;
-
-  const uint32_t now = millis();
-  if ((now - lastMs) < 20) return;
-  lastMs = now;
+  // Renders and shows a frame when one is due; never blocks.
+  if (frameLoop.poll() && (frameLoop.frame() % REPORT_FRAMES) == 0)
+  {
+    // e.g. "fps=50 frames=250 missed=0 skipped=0 overruns=0 render_us=... flush_us=..."
+    frameLoop.printStats(Serial);
+    frameLoop.resetStats();
+  }
+}
 
-  t = (uint8_t)(t + kSpeed);
+// Draw frame number `frame`: the wave phase follows the frame index, so a
+// skipped frame does not slow the animation down.
+static void renderFrame(uint32_t frame, void *)
+{
+  const uint8_t t = (uint8_t)(frame * kSpeed);
 
   // Render spatial wave:
   // phase(x,y) = t + x*dx + y*dy
@@ -130,6 +149,4 @@ void loop()
       ledMatrix.setPixel(x, y, r, g, b);
     }
   }
-
-  ledMatrix.show();
 }
@@ -13,18 +13,17 @@
 //***********        Purpose / what you will learn            */
 //*********************************************************** */
 // This is the classic "LED matrix" project: rendering shapes from a font and
-// animating them by shifting a window across a virtual, wider canvas. Unlike
-// fillScreen() examples, here you build the image pixel by pixel every frame.
+// animating them by shifting a window across a virtual, wider canvas.
 //
 // You will practice:
-//   - clearScreen()        : wipe the framebuffer before drawing each frame.
+//   - scroll(dx, dy)        : shift the framebuffer in place by one column.
 //   - setPixel(x, y, r,g,b) : light individual pixels to form glyphs.
 //   - show()               : push the finished frame to the chip in one burst.
 //   - non-blocking timing with millis() to control the scroll speed.
 //
 // Key idea: the text is treated as a virtual strip that is much WIDER than the
-// 6-pixel panel. A scroll offset slides a 6-column window across that strip;
-// for every on-screen column we look up which font column it maps to.
+// 6-pixel panel. Every step the picture moves one column to the left and only
+// the column that scrolls in on the right is decoded from the font.
 
 #include <Arduino.h>
 #include <SPI.h>
@@ -190,7 +189,7 @@ void setup()
 
 void loop()
 {
-  static uint16_t scrollPos = 0;  // Left-most virtual column shown on screen.
+  static uint16_t scrollPos = 0;  // Virtual column entering on the right.
   static uint32_t lastMs    = 0;  // Timestamp of the last scroll step.
 
   // Total width of the virtual text strip, in columns.
@@ -203,29 +202,23 @@ void loop()
     return;
   lastMs = now;
 
-  // 1. Clear the previous frame.
-  ledMatrix.clearScreen();
+  // 1. Move everything one column to the left; the right-most column is
+  //    left blank.
+  ledMatrix.scroll(-1, 0);
+
+  // 2. Find which virtual text column enters on the right, decode that
+  //    column's glyph bits and draw the lit pixels.
+  const uint16_t charIndex = scrollPos / CHAR_ADVANCE;               // which character
+  const uint8_t  colInChar = (uint8_t)(scrollPos % CHAR_ADVANCE);    // column inside it
 
-  // 2. For each on-screen column, find which virtual text column it maps to,
-  //    decode that column's glyph bits and draw the lit pixels.
-  for (uint8_t x = 0; x < WIDTH_LED_MATRIX; x++)
+  // Columns >= FONT_WIDTH are the blank spacing between characters.
+  const uint8_t glyph = charToGlyph(MESSAGE[charIndex]);
+  const uint8_t bits  = glyphColumnBits(glyph, colInChar);
+
+  for (uint8_t row = 0; row < FONT_HEIGHT; row++)
   {
-    const uint16_t vcol      = (uint16_t)(scrollPos + x) % totalCols;
-    const uint16_t charIndex = vcol / CHAR_ADVANCE;     // which character
-    const uint8_t  colInChar = (uint8_t)(vcol % CHAR_ADVANCE); // column inside it
-
-    // Columns >= FONT_WIDTH are the blank spacing between characters.
-    if (colInChar >= FONT_WIDTH)
-      continue;
-
-    const uint8_t glyph = charToGlyph(MESSAGE[charIndex]);
-    const uint8_t bits  = glyphColumnBits(glyph, colInChar);
-
-    for (uint8_t row = 0; row < FONT_HEIGHT; row++)
-    {
-      if (bits & (1u << row))
-        ledMatrix.setPixel(x, Y_OFFSET + row, TEXT_R, TEXT_G, TEXT_B);
-    }
+    if (bits & (1u << row))
+      ledMatrix.setPixel(WIDTH_LED_MATRIX - 1, Y_OFFSET + row, TEXT_R, TEXT_G, TEXT_B);
   }
 
   // 3. Push the finished frame and advance the scroll position.
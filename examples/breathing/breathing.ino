@@ -52,24 +52,15 @@ void setup()
     // This ensures that when you set PWM to maximum, the LED will shine at full brightness.
     ledMatrix.setScaling(0xFF, 0xFF, 0xFF);
 
-    // 4. Configure breathing patterns
-    // t0 rise, t1 on, t2 fall, t3 off
-    ledMatrix.configureBreathing(AwPattern::PAT0, 80, 10, 80, 10, true);
-    ledMatrix.configureBreathing(AwPattern::PAT1, 100, 10, 100, 10, true);
-    ledMatrix.configureBreathing(AwPattern::PAT2, 120, 10, 120, 10, true);
-    for (uint8_t y = 0; y < 12; y++)
-    {
-        for (uint8_t x = 0; x < 6; x++)
-        {
-            ledMatrix.setPixelPatternRGB(x, y,
-                                         AwPattern::PAT0,
-                                         AwPattern::PAT1,
-                                         AwPattern::PAT2);
-        }
-    }
-    ledMatrix.setBreathingBrightness(AwPattern::PAT0, 0x20, 0xE0); // R
-    ledMatrix.setBreathingBrightness(AwPattern::PAT1, 0x20, 0xC8); // G
-    ledMatrix.setBreathingBrightness(AwPattern::PAT2, 0x20, 0xB0); // B
+    // 4. Configure breathing patterns (timing + min/max envelope, one burst each)
+    // t0 rise, t1 on, t2 fall, t3 off, min, max
+    ledMatrix.setupBreathing(AwPattern::PAT0, 80, 10, 80, 10, 0x20, 0xE0, true);   // R
+    ledMatrix.setupBreathing(AwPattern::PAT1, 100, 10, 100, 10, 0x20, 0xC8, true); // G
+    ledMatrix.setupBreathing(AwPattern::PAT2, 120, 10, 120, 10, 0x20, 0xB0, true); // B
+    // Bind R/G/B of every pixel to PAT0/PAT1/PAT2 in RAM, then send the whole
+    // Page 3 to the chip in one burst.
+    ledMatrix.setPatternAll(AwPattern::PAT0, AwPattern::PAT1, AwPattern::PAT2);
+    ledMatrix.commitPatterns();
     ledMatrix.startBreathing(AwPattern::PAT0);
     ledMatrix.startBreathing(AwPattern::PAT1);
     ledMatrix.startBreathing(AwPattern::PAT2);
@@ -0,0 +1,98 @@
+// Host stand-in for the Arduino core, used by the off-target benchmark build.
+// Only what the driver and the example sketches call is provided. Time is
+// virtual: delay()/delayMicroseconds() advance the clock instead of sleeping,
+// so a benchmark runs as fast as the host allows and is fully deterministic.
+#ifndef AW_HOST_ARDUINO_H
+#define AW_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <type_traits>
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define memcpy_P memcpy
+#define F(str) (str)
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#ifndef constrain
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+
+template <typename T, typename U>
+static inline auto min(T a, U b) -> typename std::common_type<T, U>::type { return a < b ? a : b; }
+template <typename T, typename U>
+static inline auto max(T a, U b) -> typename std::common_type<T, U>::type { return a > b ? a : b; }
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+class HardwareSerial
+{
+public:
+    void begin(unsigned long) {}
+    void end() {}
+    operator bool() const { return true; }
+
+    int available();
+    int read();
+    void flush() {}
+
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buf, size_t len);
+
+    size_t print(const char *s);
+    size_t print(char c);
+    size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(int v, int base = DEC) { return print((long)v, base); }
+    size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = DEC);
+    size_t print(unsigned long v, int base = DEC);
+    size_t print(double v, int digits = 2);
+
+    size_t println() { return print("\n"); }
+    template <typename T>
+    size_t println(T v) { return print(v) + println(); }
+    template <typename T>
+    size_t println(T v, int fmt) { return print(v, fmt) + println(); }
+
+    size_t printf(const char *fmt, ...);
+};
+
+extern HardwareSerial Serial;
+
+#endif // AW_HOST_ARDUINO_H
@@ -0,0 +1,55 @@
+// Host stand-in for the Arduino SPI library. Every byte, CS edge and
+// transaction is forwarded to the MockBus recorder (mock_bus.h).
+#ifndef AW_HOST_SPI_H
+#define AW_HOST_SPI_H
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x02
+#define SPI_MODE3 0x03
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+class SPISettings
+{
+public:
+    SPISettings(uint32_t clock = 4000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0)
+        : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+};
+
+class SPIClass
+{
+public:
+    void begin() {}
+    void begin(int8_t, int8_t, int8_t, int8_t = -1) {}
+    void end() {}
+
+    void beginTransaction(SPISettings settings);
+    void endTransaction();
+
+    uint8_t transfer(uint8_t data);
+    void transfer(void *buf, size_t count);
+
+    // ESP32-style TX-only bulk write.
+    void writeBytes(const uint8_t *data, uint32_t size);
+
+    // Adafruit SAMD-style DMA transfer. With block == false the bytes are
+    // recorded at once but the bus reports busy until polled or waited on.
+    void transfer(const void *txbuf, void *rxbuf, size_t count, bool block = true);
+    bool isBusy();
+    void waitForTransfer();
+
+private:
+    bool _dmaBusy = false;
+};
+
+extern SPIClass SPI;
+
+#endif // AW_HOST_SPI_H
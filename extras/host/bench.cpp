@@ -0,0 +1,870 @@
+// Driver micro-benchmarks on the host mock bus.
+//
+// Each scenario runs one driver call (or a short sequence) against a freshly
+// reset MockBus and prints one CSV row with what it put on the wire:
+//
+//   name,bytes,transactions,cs_toggles,frames,est_avr_us
+//
+// `make check` compares these rows against baseline.csv. Fewer bytes only
+// count if they are the right bytes: after each scenario the emulated chip
+// must hold exactly what a reference driver on another CS pin holds after
+// writing the expected registers one writeRegister() at a time. A final check
+// runs one script through the built-in SPI path and two transports and
+// compares what they put on the wire. The bench exits non-zero on the first
+// mismatch.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AW20216S.h"
+#include "AW20216SArray.h"
+#include "AW20216SFlushTask.h"
+#include "AW20216SGroup.h"
+#include "AW20216SOffload.h"
+#include "AW20216ST.h"
+#include "mock_bus.h"
+
+#define BENCH_CS_PIN 10
+#define BENCH_REF_PIN 40 // Reference chips (one per measured chip) from here
+
+// Row prefix for builds with non-default SPI capabilities (see Makefile).
+#ifndef AW_BENCH_VARIANT
+#define AW_BENCH_VARIANT ""
+#endif
+
+static void printHeader()
+{
+    printf("name,bytes,transactions,cs_toggles,frames,est_avr_us\n");
+}
+
+static void printRow(const char *name)
+{
+    const MockBusStats &s = MockBus::stats();
+    printf("%s%s,%lu,%lu,%lu,%lu,%lu\n", AW_BENCH_VARIANT, name,
+           (unsigned long)s.bytesOut,
+           (unsigned long)s.transactions,
+           (unsigned long)s.csToggles,
+           (unsigned long)s.frames,
+           (unsigned long)MockBus::estimatedAvrMicros());
+}
+
+#if AW_ENABLE_STATS
+// The driver's own counters must agree with what the mock saw on the wire.
+static void checkStats(const char *name, AW20216SBase *const *drivers, uint8_t count)
+{
+    uint32_t bytes = 0, transactions = 0, csToggles = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const AwDriverStats &st = drivers[i]->getStats();
+        transactions += st.transactions;
+        csToggles += st.csToggles;
+        for (uint8_t p = 0; p < AW_STATS_PAGES; p++)
+            bytes += st.bytesWritten[p] + st.bytesRead[p];
+    }
+
+    const MockBusStats &s = MockBus::stats();
+    if (bytes != s.bytesOut || transactions != s.transactions || csToggles != s.csToggles)
+    {
+        fprintf(stderr, "%s%s: getStats() disagrees with the bus\n", AW_BENCH_VARIANT, name);
+        exit(1);
+    }
+}
+
+#define BENCH_RESET_STATS(drv) (drv).resetStats()
+#else
+#define BENCH_RESET_STATS(drv) ((void)0)
+#endif
+
+//******************************************************** */
+// Chip contents
+
+// Pages 0-3 of the chip behind `cs` must equal those of the chip behind
+// `refCs` (Page 4 only aliases Pages 1 and 2).
+static void checkChip(const char *name, uint8_t cs, uint8_t refCs)
+{
+    for (uint8_t page = 0; page < 4; page++)
+    {
+        for (uint16_t reg = 0; reg < 256; reg++)
+        {
+            const uint8_t got = MockBus::chipRegister(cs, page, reg);
+            const uint8_t want = MockBus::chipRegister(refCs, page, reg);
+            if (got != want)
+            {
+                fprintf(stderr, "%s%s: chip %u page %u reg 0x%02X is 0x%02X, expected 0x%02X\n",
+                        AW_BENCH_VARIANT, name, cs, page, reg, got, want);
+                exit(1);
+            }
+        }
+    }
+}
+
+// Expected Page 1: the driver's framebuffer, sent as is.
+static void expectFrame(AW20216SBase &ref, AW20216SBase &drv)
+{
+    uint8_t frame[AW_FRAME_SIZE(AW_MAX_ROWS)];
+    drv.captureFrame(frame);
+    for (uint8_t i = 0; i < AW_BASE_Y(drv.activeRows()); i++)
+        ref.writeRegister(AW20216S_PAGE1, i, frame[i]);
+}
+
+// Expected Page 2: every pixel at (r, g, b).
+static void expectScaling(AW20216SBase &ref, uint8_t r, uint8_t g, uint8_t b)
+{
+    for (uint8_t i = 0; i < AW_MAX_LEDS; i += 3)
+    {
+        ref.writeRegister(AW20216S_PAGE2, i, r);
+        ref.writeRegister(AW20216S_PAGE2, (uint8_t)(i + 1u), g);
+        ref.writeRegister(AW20216S_PAGE2, (uint8_t)(i + 2u), b);
+    }
+}
+
+// Expected Page 0 after programming a breathing engine's timers / config.
+static void expectBreathing(AW20216SBase &ref, AwPattern pat, uint8_t t0, uint8_t t1, uint8_t t2,
+                            uint8_t t3, bool logarithmic)
+{
+    const uint8_t idx = AW_PAT_INDEX(pat);
+    ref.writeRegister(AW20216S_PAGE0, (uint8_t)(AW_PAT_T_BASE(idx) + 0u), t0);
+    ref.writeRegister(AW20216S_PAGE0, (uint8_t)(AW_PAT_T_BASE(idx) + 1u), t1);
+    ref.writeRegister(AW20216S_PAGE0, (uint8_t)(AW_PAT_T_BASE(idx) + 2u), t2);
+    ref.writeRegister(AW20216S_PAGE0, (uint8_t)(AW_PAT_T_BASE(idx) + 3u), t3);
+    ref.writeRegister(AW20216S_PAGE0, AW_PAT_CFG_ADDR(idx),
+                      (uint8_t)(AW_PATCFG_PATEN | AW_PATCFG_PATMD | (logarithmic ? AW_PATCFG_LOGEN : 0u)));
+}
+
+// Expected Page 0 after setting a breathing engine's envelope.
+static void expectEnvelope(AW20216SBase &ref, AwPattern pat, uint8_t minV, uint8_t maxV)
+{
+    const uint8_t idx = AW_PAT_INDEX(pat);
+    ref.writeRegister(AW20216S_PAGE0, (uint8_t)(AW_REG_PWMH0 + idx), maxV);
+    ref.writeRegister(AW20216S_PAGE0, (uint8_t)(AW_REG_PWML0 + idx), minV);
+}
+
+//******************************************************** */
+
+// Run `prepare` on a freshly initialized driver, clear the counters, run
+// `measure` and print its row. `expect` then writes the registers the chip
+// should hold onto a reference driver, one writeRegister() at a time.
+template <typename Prepare, typename Measure, typename Expect>
+static void scenario(const char *name, Prepare prepare, Measure measure, Expect expect)
+{
+    MockBus::reset();
+    AW20216S drv(12, 6, BENCH_CS_PIN);
+    drv.begin();
+    prepare(drv);
+    MockBus::resetStats();
+    BENCH_RESET_STATS(drv);
+    measure(drv);
+    printRow(name);
+#if AW_ENABLE_STATS
+    AW20216SBase *const drivers[] = {&drv};
+    checkStats(name, drivers, 1);
+#endif
+
+    AW20216S ref(12, 6, BENCH_REF_PIN);
+    ref.begin();
+    expect(ref, drv);
+    checkChip(name, BENCH_CS_PIN, BENCH_REF_PIN);
+}
+
+template <typename Prepare, typename Measure>
+static void scenario(const char *name, Prepare prepare, Measure measure)
+{
+    scenario(name, prepare, measure, expectFrame);
+}
+
+template <typename Measure>
+static void scenario(const char *name, Measure measure)
+{
+    scenario(name, [](AW20216S &) {}, measure);
+}
+
+// 2x2 wall of 6x12 panels (12 x 24 world), one CS pin per chip.
+typedef AW20216SArray<12, 24, 4> BenchWall;
+
+template <typename Prepare, typename Measure>
+static void wallScenario(const char *name, Prepare prepare, Measure measure)
+{
+    MockBus::reset();
+    AW20216S p0(12, 6, BENCH_CS_PIN), p1(12, 6, BENCH_CS_PIN + 1),
+        p2(12, 6, BENCH_CS_PIN + 2), p3(12, 6, BENCH_CS_PIN + 3);
+    BenchWall wall;
+    wall.addPanel(p0, 0, 0);
+    wall.addPanel(p1, 6, 0);
+    wall.addPanel(p2, 0, 12, AwRotation::R180);
+    wall.addPanel(p3, 6, 12, AwRotation::R180);
+    wall.begin();
+    prepare(wall);
+    MockBus::resetStats();
+    BENCH_RESET_STATS(p0);
+    BENCH_RESET_STATS(p1);
+    BENCH_RESET_STATS(p2);
+    BENCH_RESET_STATS(p3);
+    measure(wall);
+    printRow(name);
+    AW20216SBase *const drivers[] = {&p0, &p1, &p2, &p3};
+#if AW_ENABLE_STATS
+    checkStats(name, drivers, 4);
+#endif
+
+    // Every panel's Page 1 holds its own framebuffer.
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        AW20216S ref(12, 6, (uint8_t)(BENCH_REF_PIN + i));
+        ref.begin();
+        expectFrame(ref, *drivers[i]);
+        checkChip(name, (uint8_t)(BENCH_CS_PIN + i), (uint8_t)(BENCH_REF_PIN + i));
+    }
+}
+
+static void paintWall(BenchWall &wall)
+{
+    wall.fillScreen(0x10, 0x20, 0x30);
+    wall.showAll();
+}
+
+// Four 6x12 panels on one bus, driven as a broadcast group. `expect` runs
+// per chip, as for scenario(), and also gets the chip's index.
+template <typename Measure, typename Expect>
+static void groupScenario(const char *name, Measure measure, Expect expect)
+{
+    MockBus::reset();
+    AW20216S p0(12, 6, BENCH_CS_PIN), p1(12, 6, BENCH_CS_PIN + 1),
+        p2(12, 6, BENCH_CS_PIN + 2), p3(12, 6, BENCH_CS_PIN + 3);
+    AW20216SBase *const drivers[] = {&p0, &p1, &p2, &p3};
+    AW20216SGroup group(drivers, 4);
+    group.begin();
+    MockBus::resetStats();
+    BENCH_RESET_STATS(p0);
+    BENCH_RESET_STATS(p1);
+    BENCH_RESET_STATS(p2);
+    BENCH_RESET_STATS(p3);
+    measure(group);
+    printRow(name);
+#if AW_ENABLE_STATS
+    checkStats(name, drivers, 4);
+#endif
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        AW20216S ref(12, 6, (uint8_t)(BENCH_REF_PIN + i));
+        ref.begin();
+        expect(ref, *drivers[i], i);
+        checkChip(name, (uint8_t)(BENCH_CS_PIN + i), (uint8_t)(BENCH_REF_PIN + i));
+    }
+}
+
+//******************************************************** */
+// Transports
+
+// Minimal user transport: forwards every call to the mock SPI and a CS pin,
+// like a sketch wrapping its own bus would.
+class BenchSpiTransport : public AwTransport
+{
+public:
+    explicit BenchSpiTransport(uint8_t csPin) : _csPin(csPin) {}
+
+    void begin() override
+    {
+        pinMode(_csPin, OUTPUT);
+        digitalWrite(_csPin, HIGH);
+        SPI.begin();
+    }
+    void beginTransaction() override { SPI.beginTransaction(SPISettings(AW_SPI_SPEED, MSBFIRST, SPI_MODE0)); }
+    void endTransaction() override { SPI.endTransaction(); }
+    void select() override { digitalWrite(_csPin, LOW); }
+    void deselect() override { digitalWrite(_csPin, HIGH); }
+    uint8_t transfer(uint8_t b) override { return SPI.transfer(b); }
+
+private:
+    uint8_t _csPin;
+};
+
+// What one driver puts on the wire for transportScript().
+struct BenchWire
+{
+    uint8_t bytes[4096];
+    uint32_t length;
+    uint32_t frames;
+    uint32_t transactions;
+};
+
+// Every path that reaches the bus through _select() / _transfer() and the
+// burst helpers: single writes, deltas, full bursts, Page 4, the output
+// table, pattern commits and a read.
+static void transportScript(AW20216S &drv)
+{
+    drv.begin();
+    drv.fillScreen(0x10, 0x20, 0x30);
+    drv.show();
+    drv.setPixel(2, 5, 0xFF, 0x00, 0x00);
+    drv.show();
+    drv.setScaling(0xFF, 0xC8, 0xB0);
+#if AW_ENABLE_SCALING_BUFFER
+    drv.setPixelScaling(4, 7, 0x80, 0x90, 0xA0);
+    drv.showWithScaling();
+#endif
+    drv.setupBreathing(AwPattern::PAT1, 80, 10, 80, 10, 0x20, 0xE0, true);
+    drv.startBreathing(AwPattern::PAT1);
+    drv.setPixelPatternRGB(3, 4, AwPattern::PAT0, AwPattern::PAT1, AwPattern::PAT2);
+    drv.commitPatterns();
+    drv.setOutputLut(AwColorLut<>::table);
+    drv.setPixel(0, 0, 0x40, 0x80, 0xC0);
+    drv.show();
+    drv.setOutputLut(nullptr);
+    drv.readRegister(AW20216S_PAGE0, AW_REG_GCR);
+}
+
+// A forwarding transport and AwRecorderTransport must see exactly the bytes,
+// CS frames and transactions the built-in SPI path produces, and leave the
+// chip in the same state.
+static void checkTransports()
+{
+    static BenchWire builtIn, forwarded, recorded;
+    const uint8_t gcr = (uint8_t)(AW_GCR_SWSEL(12) | AW_GLOBAL_ENABLE);
+
+    MockBus::reset();
+    {
+        AW20216S drv(12, 6, BENCH_CS_PIN);
+        MockBus::captureOutput(builtIn.bytes, sizeof(builtIn.bytes));
+        transportScript(drv);
+        builtIn.length = MockBus::capturedLength();
+        builtIn.frames = MockBus::stats().frames;
+        builtIn.transactions = MockBus::stats().transactions;
+    }
+
+    MockBus::resetStats();
+    {
+        BenchSpiTransport bus(BENCH_REF_PIN);
+        AW20216S drv(12, 6, BENCH_CS_PIN + 1); // CS pin unused on a transport
+        drv.setTransport(&bus);
+        MockBus::captureOutput(forwarded.bytes, sizeof(forwarded.bytes));
+        transportScript(drv);
+        forwarded.length = MockBus::capturedLength();
+        forwarded.frames = MockBus::stats().frames;
+        forwarded.transactions = MockBus::stats().transactions;
+        MockBus::captureOutput(nullptr, 0);
+    }
+    checkChip("transport_forwarding", BENCH_REF_PIN, BENCH_CS_PIN);
+
+    {
+        AwRecorderTransport recorder(recorded.bytes, sizeof(recorded.bytes));
+        recorder.setReadValue(gcr); // What begin() reads back
+        AW20216S drv(12, 6, BENCH_CS_PIN + 1);
+        drv.setTransport(&recorder);
+        transportScript(drv);
+        recorded.length = (uint32_t)recorder.length() + recorder.overflow();
+        recorded.frames = recorder.frames();
+        recorded.transactions = recorder.transactions();
+    }
+
+    const BenchWire *paths[] = {&forwarded, &recorded};
+    const char *names[] = {"forwarding", "recorder"};
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        const BenchWire &w = *paths[i];
+        if (builtIn.length > sizeof(builtIn.bytes) || w.length != builtIn.length ||
+            w.frames != builtIn.frames || w.transactions != builtIn.transactions ||
+            memcmp(w.bytes, builtIn.bytes, builtIn.length) != 0)
+        {
+            fprintf(stderr,
+                    "%stransport_%s: %lu bytes / %lu frames / %lu transactions, built-in SPI "
+                    "%lu / %lu / %lu%s\n",
+                    AW_BENCH_VARIANT, names[i], (unsigned long)w.length, (unsigned long)w.frames,
+                    (unsigned long)w.transactions, (unsigned long)builtIn.length,
+                    (unsigned long)builtIn.frames, (unsigned long)builtIn.transactions,
+                    w.length == builtIn.length ? " (bytes differ)" : "");
+            exit(1);
+        }
+    }
+}
+
+static uint8_t benchRing[AW_VIEWPORT_SIZE(12, 32)];
+static uint8_t benchScene[AW_FRAME_SIZE(12)];
+static uint8_t benchFrom[AW_FRAME_SIZE(12)];
+static uint8_t benchIndexed[AW_INDEXED_SIZE(12, 4)];
+static uint8_t benchPalette[16 * 3];
+
+static void paintFrame(AW20216S &drv)
+{
+    drv.fillScreen(0x10, 0x20, 0x30);
+    drv.show();
+}
+
+//******************************************************** */
+// Blends
+
+enum class BenchBlend : uint8_t { Lerp, Add, Max };
+
+// benchFrom on the panel (blitRGB(), not a blend kernel), benchScene as the
+// second operand; both ramps wrap through 0-255 at different rates.
+static void loadRamps(AW20216S &drv)
+{
+    for (uint16_t i = 0; i < sizeof(benchFrom); i++)
+    {
+        benchFrom[i] = (uint8_t)(i * 37u + 11u);
+        benchScene[i] = (uint8_t)(i * 13u + 90u);
+    }
+    drv.blitRGB(0, 0, 6, 12, benchFrom);
+    drv.show();
+}
+
+// Expected Page 1: benchFrom op benchScene, one byte at a time.
+static void expectBlend(AW20216SBase &ref, BenchBlend op, uint8_t t)
+{
+    const uint16_t w = (uint16_t)(t + (t >> 7));
+    for (uint8_t i = 0; i < AW_FRAME_SIZE(12); i++)
+    {
+        const uint16_t a = benchFrom[i], b = benchScene[i];
+        uint16_t v;
+        if (op == BenchBlend::Lerp)
+            v = (uint16_t)((a * (256u - w) + b * w + 128u) >> 8); // Rounded
+        else if (op == BenchBlend::Add)
+            v = (a + b > 255u) ? 255u : (uint16_t)(a + b);
+        else
+            v = (a > b) ? a : b;
+        ref.writeRegister(AW20216S_PAGE1, i, (uint8_t)v);
+    }
+}
+
+//******************************************************** */
+// Breathing offload
+
+// Rows 0-5 / rows 4-7, columns 0-2 / row 5 / row 0 / row 10 / row 11.
+static const uint8_t benchTopRows[12] = {0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F};
+static const uint8_t benchBand[12] = {0, 0, 0, 0, 0x07, 0x07, 0x07, 0x07};
+static const uint8_t benchRow5[12] = {0, 0, 0, 0, 0, 0x3F};
+static const uint8_t benchRow0[12] = {0x3F};
+static const uint8_t benchRow10[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x3F};
+static const uint8_t benchRow11[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x3F};
+
+// 2 s period (AW_PAT_TICK_MS = 10): rise 60, on 40, fall 60, off 40 steps.
+static const AwBreathEffect benchEffects[] = {
+    {2000, 20, 30, 0x10, 0xF0, 0, false, benchTopRows, AW_CH_RGB},    // PAT0
+    {2000, 20, 30, 0x10, 0xF0, 0, false, benchBand, AW_CH_MASK(1)},   // Shares PAT0
+    {2000, 20, 30, 0x10, 0xF0, 1, false, benchRow5, AW_CH_MASK(0) | AW_CH_MASK(2)}, // Group 1: PAT1
+    {10000, 20, 30, 0x00, 0xFF, 0, false, benchRow0, AW_CH_MASK(2)},  // 300-step ramps: Range
+    {1000, 0, 50, 0x00, 0xFF, 2, true, benchRow10, AW_CH_RGB},        // PAT2
+    {3000, 50, 25, 0x00, 0xFF, 0, false, benchRow11, AW_CH_RGB}       // No engine left
+};
+#define BENCH_EFFECTS (uint8_t)(sizeof(benchEffects) / sizeof(benchEffects[0]))
+
+// Where each effect must land.
+static const AwPattern benchEngines[BENCH_EFFECTS] = {
+    AwPattern::PAT0, AwPattern::PAT0, AwPattern::PAT1,
+    AwPattern::PWM, AwPattern::PAT2, AwPattern::PWM};
+static const AwOffloadStatus benchStatus[BENCH_EFFECTS] = {
+    AwOffloadStatus::Engine, AwOffloadStatus::Engine, AwOffloadStatus::Engine,
+    AwOffloadStatus::Range, AwOffloadStatus::Engine, AwOffloadStatus::NoEngine};
+
+static void checkOffload(const AW20216SOffload &offload, uint16_t fallback)
+{
+    bool ok = fallback == 0x28 && offload.fallbackMask() == fallback && offload.enginesUsed() == 3;
+    for (uint8_t i = 0; i < BENCH_EFFECTS; i++)
+        ok = ok && offload.engine(i) == benchEngines[i] && offload.status(i) == benchStatus[i];
+
+    // MCU fallback follows the engine's envelope: rest, mid-rise, top.
+    ok = ok && AW20216SOffload::level(benchEffects[0], 0) == 0x10 &&
+         AW20216SOffload::level(benchEffects[0], 300) == 0x7F &&
+         AW20216SOffload::level(benchEffects[0], 600) == 0xF0;
+
+    if (!ok)
+    {
+        fprintf(stderr, "%soffload_apply_start: fallback 0x%04X, %u engines, unexpected allocation\n",
+                AW_BENCH_VARIANT, fallback, offload.enginesUsed());
+        exit(1);
+    }
+}
+
+// Page 3 as the effects bind it, later effects winning, computed per channel.
+static void expectOffloadPatterns(AW20216SBase &ref)
+{
+    uint8_t regs[AW_MAX_LEDS / 3u];
+    memset(regs, 0, sizeof(regs));
+    for (uint8_t i = 0; i < BENCH_EFFECTS; i++)
+    {
+        const AwBreathEffect &e = benchEffects[i];
+        for (uint8_t y = 0; y < 12; y++)
+            for (uint8_t x = 0; x < 6; x++)
+                for (uint8_t ch = 0; ch < 3; ch++)
+                {
+                    if (!(e.rowMasks[y] & (1u << x)) || !(e.channels & AW_CH_MASK(ch)))
+                        continue;
+                    uint8_t &reg = regs[y * 6u + x];
+                    reg = (uint8_t)((reg & ~(0x03u << (2u * ch))) |
+                                    ((uint8_t)benchEngines[i] << (2u * ch)));
+                }
+    }
+    for (uint8_t reg = 0; reg < sizeof(regs); reg++)
+        ref.writeRegister(AW20216S_PAGE3, reg, regs[reg]);
+}
+
+int main()
+{
+    printHeader();
+
+    {
+        MockBus::reset();
+        AW20216S drv(12, 6, BENCH_CS_PIN);
+        drv.begin();
+        printRow("begin");
+
+        AW20216S ref(12, 6, BENCH_REF_PIN);
+        ref.begin();
+        ref.writeRegister(AW20216S_PAGE0, AW_REG_RSTN, AW_RST_CMD);
+        ref.writeRegister(AW20216S_PAGE0, AW_REG_GCR, (uint8_t)(AW_GCR_SWSEL(12) | AW_GLOBAL_ENABLE));
+        ref.writeRegister(AW20216S_PAGE0, AW_REG_GCCR, 0x80);
+        checkChip("begin", BENCH_CS_PIN, BENCH_REF_PIN);
+    }
+
+    scenario("show_full_frame", paintFrame);
+
+    scenario("show_one_pixel", paintFrame, [](AW20216S &drv) {
+        drv.setPixel(2, 5, 0xFF, 0x00, 0x00);
+        drv.show();
+    });
+
+    scenario("show_unchanged", paintFrame, paintFrame);
+
+    // A raw Page 4 write lands in PWM: the next delta show() must restore it.
+    scenario("show_after_page4_write", paintFrame, [](AW20216S &drv) {
+        drv.writeRegister(AW20216S_PAGE4, 0, 0xAA);
+        drv.setPixel(0, 0, 0x10, 0x20, 0x30);
+        drv.show();
+    });
+
+    {
+        // Compile-time 6x6 panel: frames only cover its 6 rows.
+        MockBus::reset();
+        AW20216ST<6, 6> drv(BENCH_CS_PIN);
+        drv.begin();
+        MockBus::resetStats();
+        drv.fillScreen(0x10, 0x20, 0x30);
+        drv.show();
+        printRow("st6x6_show_full_frame");
+
+        AW20216S ref(6, 6, BENCH_REF_PIN);
+        ref.begin();
+        expectFrame(ref, drv);
+        checkChip("st6x6_show_full_frame", BENCH_CS_PIN, BENCH_REF_PIN);
+    }
+
+    scenario("show_full_frame_lut", [](AW20216S &drv) {
+        drv.setOutputLut(AwColorLut<>::table);
+    }, paintFrame, [](AW20216S &ref, AW20216S &drv) {
+        // Page 1 holds the table entries, R / G / B rows by register % 3.
+        uint8_t frame[AW_FRAME_SIZE(12)];
+        drv.captureFrame(frame);
+        for (uint8_t i = 0; i < AW_MAX_LEDS; i++)
+            ref.writeRegister(AW20216S_PAGE1, i,
+                              pgm_read_byte(&AwColorLut<>::table[(uint16_t)(i % 3u) * 256u + frame[i]]));
+    });
+
+    scenario("scroll_marquee_step", paintFrame, [](AW20216S &drv) {
+        drv.scroll(-1, 0);
+        drv.drawVLine(5, 3, 5, 0x00, 0xB4, 0xFF);
+        drv.show();
+    });
+
+    // One step of a crossfade from paintFrame() to a half-lit scene.
+    scenario("crossfade_step", [](AW20216S &drv) {
+        drv.fillRect(0, 0, 6, 6, 0xFF, 0x80, 0x00);
+        drv.captureFrame(benchScene);
+        paintFrame(drv);
+    }, [](AW20216S &drv) {
+        drv.captureFrame(benchFrom);
+        drv.crossfade(benchFrom, benchScene, 32);
+        drv.show();
+    }, [](AW20216S &ref, AW20216S &) {
+        expectBlend(ref, BenchBlend::Lerp, 32);
+    });
+
+    // Blend kernels on frames that cover every byte value and lane position,
+    // checked against a scalar reference (blendAdd saturates about half).
+    scenario("crossfade_ramp", loadRamps, [](AW20216S &drv) {
+        drv.crossfade(benchFrom, benchScene, 200);
+        drv.show();
+    }, [](AW20216S &ref, AW20216S &) {
+        expectBlend(ref, BenchBlend::Lerp, 200);
+    });
+
+    scenario("blendAdd_saturate", loadRamps, [](AW20216S &drv) {
+        drv.blendAdd(benchScene);
+        drv.show();
+    }, [](AW20216S &ref, AW20216S &) {
+        expectBlend(ref, BenchBlend::Add, 0);
+    });
+
+    scenario("blendMax", loadRamps, [](AW20216S &drv) {
+        drv.blendMax(benchScene);
+        drv.show();
+    }, [](AW20216S &ref, AW20216S &) {
+        expectBlend(ref, BenchBlend::Max, 0);
+    });
+
+    // Palette animation on a 4 bpp indexed frame: no pixel is touched.
+    scenario("indexed_palette_cycle", [](AW20216S &drv) {
+        drv.setIndexedFrame(benchIndexed, 4, benchPalette, 16);
+        for (uint8_t i = 0; i < 16; i++)
+            drv.setPaletteColor(i, (uint8_t)(i * 16u), 0x20, (uint8_t)(255u - i * 16u));
+        for (uint8_t y = 0; y < 12; y++)
+            for (uint8_t x = 0; x < 6; x++)
+                drv.setIndex(x, y, (uint8_t)(x + y));
+        drv.show();
+    }, [](AW20216S &drv) {
+        drv.rotatePalette(0, 16);
+        drv.show();
+    }, [](AW20216S &ref, AW20216S &drv) {
+        for (uint8_t y = 0; y < 12; y++)
+            for (uint8_t x = 0; x < 6; x++)
+                for (uint8_t c = 0; c < 3; c++)
+                    ref.writeRegister(AW20216S_PAGE1, (uint8_t)(AW_BASE_INDEX(x, y) + c),
+                                      benchPalette[drv.getIndex(x, y) * 3u + c]);
+    });
+
+    // A queued frame flushed by the consumer side: same traffic as show().
+    scenario("flush_queue_frame", [](AW20216S &drv) {
+        drv.fillRect(0, 0, 6, 6, 0xFF, 0x80, 0x00);
+        drv.captureFrame(benchScene);
+        paintFrame(drv);
+    }, [](AW20216S &drv) {
+        AW20216SBase *const chips[] = {&drv};
+        AW20216SFlushTaskT<2> flush(chips, 1);
+        flush.submitFrame(benchScene);
+        flush.service();
+    });
+
+    scenario("viewport_marquee_step", [](AW20216S &drv) {
+        drv.setViewport(benchRing, 32);
+        drv.show();
+    }, [](AW20216S &drv) {
+        drv.fillViewportColumn(6, 0x00, 0xB4, 0xFF);
+        drv.scrollViewport(1);
+        drv.show();
+    }, [](AW20216S &ref, AW20216S &) {
+        // Window starts at ring column 1.
+        for (uint8_t y = 0; y < 12; y++)
+            for (uint8_t x = 0; x < 6; x++)
+                for (uint8_t c = 0; c < 3; c++)
+                    ref.writeRegister(AW20216S_PAGE1, (uint8_t)(AW_BASE_INDEX(x, y) + c),
+                                      benchRing[((uint16_t)y * 32u + x + 1u) * 3u + c]);
+    });
+
+    scenario("showAsync_full_frame", [](AW20216S &) {}, [](AW20216S &drv) {
+        drv.fillScreen(0x10, 0x20, 0x30);
+        drv.showAsync();
+        drv.waitShow();
+    }, [](AW20216S &ref, AW20216S &) {
+        for (uint8_t i = 0; i < AW_MAX_LEDS; i++)
+            ref.writeRegister(AW20216S_PAGE1, i, (uint8_t)(0x10u * (i % 3u + 1u)));
+    });
+
+    // Incremental drawing: only DMA cores swap buffers (and resend it all).
+    scenario("showAsync_one_pixel", paintFrame, [](AW20216S &drv) {
+        drv.setPixel(2, 5, 0xFF, 0x00, 0x00);
+        drv.showAsync();
+        drv.waitShow();
+    }, [](AW20216S &ref, AW20216S &) {
+        for (uint8_t i = 0; i < AW_MAX_LEDS; i++)
+            ref.writeRegister(AW20216S_PAGE1, i, (uint8_t)(0x10u * (i % 3u + 1u)));
+        ref.writeRegister(AW20216S_PAGE1, (uint8_t)(AW_BASE_INDEX(2, 5) + 0u), 0xFF);
+        ref.writeRegister(AW20216S_PAGE1, (uint8_t)(AW_BASE_INDEX(2, 5) + 1u), 0x00);
+        ref.writeRegister(AW20216S_PAGE1, (uint8_t)(AW_BASE_INDEX(2, 5) + 2u), 0x00);
+    });
+
+#if AW_ENABLE_SCALING_BUFFER
+    scenario("showWithScaling", [](AW20216S &) {}, [](AW20216S &drv) {
+        drv.fillScreen(0x10, 0x20, 0x30);
+        drv.setPixelScaling(1, 1, 0xFF, 0x80, 0x40);
+        drv.showWithScaling();
+    }, [](AW20216S &ref, AW20216S &drv) {
+        expectFrame(ref, drv);
+        expectScaling(ref, 0xFF, 0xFF, 0xFF);
+        ref.writeRegister(AW20216S_PAGE2, (uint8_t)(AW_BASE_INDEX(1, 1) + 1u), 0x80);
+        ref.writeRegister(AW20216S_PAGE2, (uint8_t)(AW_BASE_INDEX(1, 1) + 2u), 0x40);
+    });
+
+    scenario("setPixelScaling_showScaling", [](AW20216S &) {}, [](AW20216S &drv) {
+        drv.setPixelScaling(4, 7, 0xF0, 0xE0, 0xD0);
+        drv.showScaling();
+    }, [](AW20216S &ref, AW20216S &) {
+        expectScaling(ref, 0xFF, 0xFF, 0xFF);
+        ref.writeRegister(AW20216S_PAGE2, (uint8_t)(AW_BASE_INDEX(4, 7) + 0u), 0xF0);
+        ref.writeRegister(AW20216S_PAGE2, (uint8_t)(AW_BASE_INDEX(4, 7) + 1u), 0xE0);
+        ref.writeRegister(AW20216S_PAGE2, (uint8_t)(AW_BASE_INDEX(4, 7) + 2u), 0xD0);
+    });
+#endif
+
+    scenario("setScaling", [](AW20216S &) {}, [](AW20216S &drv) {
+        drv.setScaling(0xFF, 0xC8, 0xB0);
+    }, [](AW20216S &ref, AW20216S &) {
+        expectScaling(ref, 0xFF, 0xC8, 0xB0);
+    });
+
+    scenario("configureBreathing", [](AW20216S &) {}, [](AW20216S &drv) {
+        drv.configureBreathing(AwPattern::PAT0, 80, 10, 80, 10, true);
+    }, [](AW20216S &ref, AW20216S &) {
+        expectBreathing(ref, AwPattern::PAT0, 80, 10, 80, 10, true);
+    });
+
+    scenario("setBreathingBrightness", [](AW20216S &) {}, [](AW20216S &drv) {
+        drv.setBreathingBrightness(AwPattern::PAT0, 0x20, 0xE0);
+    }, [](AW20216S &ref, AW20216S &) {
+        expectEnvelope(ref, AwPattern::PAT0, 0x20, 0xE0);
+    });
+
+    scenario("setupBreathing", [](AW20216S &) {}, [](AW20216S &drv) {
+        drv.setupBreathing(AwPattern::PAT0, 80, 10, 80, 10, 0x20, 0xE0, true);
+    }, [](AW20216S &ref, AW20216S &) {
+        expectBreathing(ref, AwPattern::PAT0, 80, 10, 80, 10, true);
+        expectEnvelope(ref, AwPattern::PAT0, 0x20, 0xE0);
+    });
+
+    // PAT2CFG is 0x44, one below PATGO: only PATEN drops, the mode bits stay.
+    scenario("enableBreathing_off", [](AW20216S &drv) {
+        drv.configureBreathing(AwPattern::PAT2, 80, 10, 80, 10, true);
+    }, [](AW20216S &drv) {
+        drv.enableBreathing(AwPattern::PAT2, false);
+    }, [](AW20216S &ref, AW20216S &) {
+        expectBreathing(ref, AwPattern::PAT2, 80, 10, 80, 10, true);
+        ref.writeRegister(AW20216S_PAGE0, AW_PAT_CFG_ADDR(AW_PAT_INDEX(AwPattern::PAT2)),
+                          (uint8_t)(AW_PATCFG_PATMD | AW_PATCFG_LOGEN));
+    });
+
+    // Page 3: one register per RGB triplet, 2 bits per channel (PAT0 = 1).
+    scenario("setPixelPatternRGB", [](AW20216S &) {}, [](AW20216S &drv) {
+        drv.setPixelPatternRGB(3, 4, AwPattern::PAT0, AwPattern::PAT1, AwPattern::PAT2);
+    }, [](AW20216S &ref, AW20216S &) {
+        ref.writeRegister(AW20216S_PAGE3, (uint8_t)(AW_BASE_INDEX(3, 4) / 3u), 0x39);
+    });
+
+    scenario("setPixelPatternRGB_full_panel", [](AW20216S &) {}, [](AW20216S &drv) {
+        for (uint8_t y = 0; y < 12; y++)
+            for (uint8_t x = 0; x < 6; x++)
+                drv.setPixelPatternRGB(x, y, AwPattern::PAT0, AwPattern::PAT0, AwPattern::PAT0);
+    }, [](AW20216S &ref, AW20216S &) {
+        for (uint8_t reg = 0; reg < AW_MAX_LEDS / 3u; reg++)
+            ref.writeRegister(AW20216S_PAGE3, reg, 0x15);
+    });
+
+    scenario("setPatternAll_commit", [](AW20216S &) {}, [](AW20216S &drv) {
+        drv.setPatternAll(AwPattern::PAT0, AwPattern::PAT1, AwPattern::PAT2);
+        drv.commitPatterns();
+    }, [](AW20216S &ref, AW20216S &) {
+        for (uint8_t reg = 0; reg < AW_MAX_LEDS / 3u; reg++)
+            ref.writeRegister(AW20216S_PAGE3, reg, 0x39);
+    });
+
+    // Six effects: two share PAT0, another group takes PAT1, one cannot be
+    // timed, one takes PAT2 and the last finds no engine left.
+    scenario("offload_apply_start", [](AW20216S &) {}, [](AW20216S &drv) {
+        AW20216SOffload offload(drv);
+        const uint16_t fallback = offload.apply(benchEffects, BENCH_EFFECTS);
+        offload.start();
+        checkOffload(offload, fallback);
+    }, [](AW20216S &ref, AW20216S &) {
+        expectBreathing(ref, AwPattern::PAT0, 60, 40, 60, 40, false);
+        expectEnvelope(ref, AwPattern::PAT0, 0x10, 0xF0);
+        expectBreathing(ref, AwPattern::PAT1, 60, 40, 60, 40, false);
+        expectEnvelope(ref, AwPattern::PAT1, 0x10, 0xF0);
+        expectBreathing(ref, AwPattern::PAT2, 50, 0, 50, 0, true);
+        expectEnvelope(ref, AwPattern::PAT2, 0x00, 0xFF);
+        ref.writeRegister(AW20216S_PAGE0, AW_REG_PATGO, 0x07);
+        expectOffloadPatterns(ref);
+    });
+
+    scenario("resyncFromChip", [](AW20216S &drv) {
+        drv.resyncFromChip();
+    });
+
+    scenario("scanFaults", [](AW20216S &drv) {
+        AwFaultMap map;
+        drv.scanFaults(map);
+    });
+
+    wallScenario("array4_showAll_full", [](BenchWall &) {}, paintWall);
+
+    wallScenario("array4_show_each_full", [](BenchWall &wall) {
+        wall.fillScreen(0x10, 0x20, 0x30);
+        wall.showAll();
+        for (uint8_t i = 0; i < wall.panelCount(); i++)
+            wall.panel(i).fillScreen(0x30, 0x20, 0x10);
+    }, [](BenchWall &wall) {
+        // What a hand-rolled showAll() costs: one transaction per chip.
+        for (uint8_t i = 0; i < wall.panelCount(); i++)
+            wall.panel(i).show();
+    });
+
+    wallScenario("array4_showAll_one_pixel", paintWall, [](BenchWall &wall) {
+        wall.setPixel(7, 15, 0xFF, 0x00, 0x00);
+        wall.showAll();
+    });
+
+    wallScenario("array4_showAll_unchanged", paintWall, [](BenchWall &wall) {
+        wall.showAll();
+    });
+
+    // Same setup / frame on four chips: one CS frame reaches all of them.
+    groupScenario("group4_setupBreathing", [](AW20216SGroup &group) {
+        group.setupBreathing(AwPattern::PAT0, 3, 1, 3, 1, 0x00, 0xFF);
+        group.startBreathing(AwPattern::PAT0);
+    }, [](AW20216S &ref, AW20216SBase &, uint8_t) {
+        expectBreathing(ref, AwPattern::PAT0, 3, 1, 3, 1, false);
+        expectEnvelope(ref, AwPattern::PAT0, 0x00, 0xFF);
+        ref.writeRegister(AW20216S_PAGE0, AW_REG_PATGO, 0x01);
+    });
+
+    groupScenario("group4_showFrame_full", [](AW20216SGroup &group) {
+        memset(benchScene, 0x40, sizeof(benchScene));
+        group.showFrame(benchScene);
+    }, [](AW20216S &ref, AW20216SBase &drv, uint8_t) {
+        expectFrame(ref, drv);
+    });
+
+    // Group calls, then one pixel per chip shown on its own: every chip must
+    // match a driver that made the same calls alone.
+    groupScenario("group4_breathing_frame_then_show", [](AW20216SGroup &group) {
+        for (uint16_t i = 0; i < sizeof(benchScene); i++)
+            benchScene[i] = (uint8_t)(i * 7u);
+        group.setupBreathing(AwPattern::PAT1, 80, 10, 80, 10, 0x20, 0xE0, true);
+        group.startBreathing(AwPattern::PAT1);
+        group.showFrame(benchScene);
+        for (uint8_t i = 0; i < group.count(); i++)
+        {
+            group.chip(i).setPixel(i, 2, 0xFF, (uint8_t)(i * 0x20u), 0x00);
+            group.chip(i).show();
+        }
+    }, [](AW20216S &ref, AW20216SBase &drv, uint8_t) {
+        uint8_t frame[AW_FRAME_SIZE(AW_MAX_ROWS)];
+        ref.setupBreathing(AwPattern::PAT1, 80, 10, 80, 10, 0x20, 0xE0, true);
+        ref.startBreathing(AwPattern::PAT1);
+        ref.crossfade(benchScene, benchScene, 255);
+        ref.show();
+        drv.captureFrame(frame); // benchScene plus this chip's own pixel
+        ref.crossfade(frame, frame, 255);
+        ref.show();
+    });
+
+    // Chip 1 runs its own PAT1 program: the group's PAT0 and PAT1 bursts
+    // span it, so they must not carry chip 0's copy over to chip 1.
+    groupScenario("group4_breathing_own_pat1", [](AW20216SGroup &group) {
+        group.chip(1).setupBreathing(AwPattern::PAT1, 50, 60, 70, 80, 0x11, 0xEE, true);
+        group.setupBreathing(AwPattern::PAT0, 3, 1, 3, 1, 0x00, 0xFF);
+        group.configureBreathing(AwPattern::PAT2, 9, 8, 7, 6);
+        group.setBreathingBrightness(AwPattern::PAT0, 0x08, 0xF8);
+        group.startBreathing(AwPattern::PAT0);
+        group.chip(1).setBreathingBrightness(AwPattern::PAT1, 0x22, 0xDD);
+    }, [](AW20216S &ref, AW20216SBase &, uint8_t chip) {
+        if (chip == 1)
+            ref.setupBreathing(AwPattern::PAT1, 50, 60, 70, 80, 0x11, 0xEE, true);
+        ref.setupBreathing(AwPattern::PAT0, 3, 1, 3, 1, 0x00, 0xFF);
+        ref.configureBreathing(AwPattern::PAT2, 9, 8, 7, 6);
+        ref.setBreathingBrightness(AwPattern::PAT0, 0x08, 0xF8);
+        ref.startBreathing(AwPattern::PAT0);
+        if (chip == 1)
+            ref.setBreathingBrightness(AwPattern::PAT1, 0x22, 0xDD);
+    });
+
+    checkTransports();
+
+    return 0;
+}
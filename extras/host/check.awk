@@ -0,0 +1,44 @@
+# Regression gate: compare a results table against the baseline, row by row.
+# Fails if any bytes / transactions / cs_toggles / frames value grew, or if a
+# baseline row disappeared. Improvements are reported so the baseline can be
+# refreshed with `make baseline`.
+#
+# Usage: awk -F, -f check.awk baseline.csv results.csv
+
+FNR == 1 { next } # header
+
+NR == FNR {
+    base[$1] = $0
+    next
+}
+
+{
+    seen[$1] = 1
+    if (!($1 in base)) {
+        printf("new     %s\n", $1)
+        next
+    }
+    split(base[$1], b, ",")
+    for (i = 2; i <= 5; i++) {
+        if ($i + 0 > b[i] + 0) {
+            printf("WORSE   %s: %s -> %s (column %d)\n", $1, b[i], $i, i)
+            failed = 1
+        } else if ($i + 0 < b[i] + 0) {
+            printf("better  %s: %s -> %s (column %d)\n", $1, b[i], $i, i)
+        }
+    }
+}
+
+END {
+    for (k in base) {
+        if (!(k in seen)) {
+            printf("MISSING %s\n", k)
+            failed = 1
+        }
+    }
+    if (failed) {
+        print "bench check FAILED"
+        exit 1
+    }
+    print "bench check OK"
+}
@@ -0,0 +1,58 @@
+// Runs one example sketch on the host mock bus and reports its SPI cost.
+//
+// The sketch is compiled as its own translation unit; this file drives
+// setup() once, then loop() over AW_BENCH_WINDOW_MS of virtual time, and
+// prints two CSV rows (same columns as bench.cpp):
+//
+//   example/<name>/setup,...   everything setup() sent
+//   example/<name>/loop_1s,... loop() traffic averaged over one second
+#include <stdio.h>
+
+#include "Arduino.h"
+#include "mock_bus.h"
+
+#ifndef AW_EXAMPLE_NAME
+#define AW_EXAMPLE_NAME "unknown"
+#endif
+
+#ifndef AW_BENCH_WINDOW_MS
+#define AW_BENCH_WINDOW_MS 10000u
+#endif
+
+// Virtual time spent per loop() pass besides the sketch's own delay()s, so
+// millis()-paced sketches make progress.
+#define AW_BENCH_LOOP_US 100u
+
+void setup();
+void loop();
+
+static void printRow(const char *phase, uint32_t divisor)
+{
+    const MockBusStats &s = MockBus::stats();
+    printf("example/%s/%s,%lu,%lu,%lu,%lu,%lu\n", AW_EXAMPLE_NAME, phase,
+           (unsigned long)(s.bytesOut / divisor),
+           (unsigned long)(s.transactions / divisor),
+           (unsigned long)(s.csToggles / divisor),
+           (unsigned long)(s.frames / divisor),
+           (unsigned long)(MockBus::estimatedAvrMicros() / divisor));
+}
+
+int main()
+{
+    MockBus::reset();
+    MockBus::setSerialInput("50\n");
+
+    setup();
+    printRow("setup", 1);
+
+    MockBus::resetStats();
+    const uint64_t end = MockBus::nowMicros() + (uint64_t)AW_BENCH_WINDOW_MS * 1000u;
+    while (MockBus::nowMicros() < end)
+    {
+        loop();
+        MockBus::advanceMicros(AW_BENCH_LOOP_US);
+    }
+    printRow("loop_1s", AW_BENCH_WINDOW_MS / 1000u);
+
+    return 0;
+}
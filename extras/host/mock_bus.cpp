@@ -0,0 +1,433 @@
+#include "mock_bus.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "SPI.h"
+
+HardwareSerial Serial;
+SPIClass SPI;
+
+//******************************************************** */
+// Emulated chips
+
+namespace
+{
+    struct Chip
+    {
+        bool used;
+        uint8_t csPin;
+        uint8_t regs[MOCK_PAGES][MOCK_PAGE_SIZE];
+    };
+
+    // Decoder state of the frame currently on the wire.
+    enum class FrameState : uint8_t { Command, Address, Data };
+
+    Chip g_chips[MOCK_MAX_CHIPS];
+    uint8_t g_pinLevel[256];
+    bool g_pinIsOutput[256];
+    MockBusStats g_stats;
+    uint64_t g_nowUs = 0;
+    uint32_t g_rand = 1;
+    const char *g_serialIn = "";
+
+    uint8_t *g_capture = nullptr;
+    uint32_t g_captureSize = 0;
+    uint32_t g_captureLen = 0;
+
+    FrameState g_state = FrameState::Command;
+    uint8_t g_page = 0;
+    bool g_read = false;
+    uint16_t g_addr = 0;
+
+    Chip *findChip(uint8_t csPin, bool create)
+    {
+        for (Chip &c : g_chips)
+            if (c.used && c.csPin == csPin)
+                return &c;
+        if (!create)
+            return nullptr;
+        for (Chip &c : g_chips)
+        {
+            if (!c.used)
+            {
+                memset(&c, 0, sizeof(c));
+                c.used = true;
+                c.csPin = csPin;
+                return &c;
+            }
+        }
+        return nullptr;
+    }
+
+    bool isSelected(const Chip &c)
+    {
+        return c.used && g_pinIsOutput[c.csPin] && g_pinLevel[c.csPin] == LOW;
+    }
+
+    void chipWrite(Chip &c, uint8_t page, uint16_t addr, uint8_t value)
+    {
+        if (page >= MOCK_PAGES || addr >= MOCK_PAGE_SIZE)
+            return;
+
+        if (page == 4)
+        {
+            // Virtual page: even addresses land in PWM, odd ones in scaling.
+            const uint16_t led = addr >> 1;
+            if (led < MOCK_PAGE_SIZE)
+                c.regs[(addr & 1u) ? 2 : 1][led] = value;
+            return;
+        }
+
+        c.regs[page][addr] = value;
+
+        // Soft reset: every register returns to its power-on value (0).
+        if (page == 0 && addr == 0x2F && value == 0xAE)
+            memset(c.regs, 0, sizeof(c.regs));
+    }
+}
+
+//******************************************************** */
+// MockBus
+
+void MockBus::reset()
+{
+    memset(g_chips, 0, sizeof(g_chips));
+    memset(g_pinLevel, HIGH, sizeof(g_pinLevel));
+    memset(g_pinIsOutput, 0, sizeof(g_pinIsOutput));
+    g_state = FrameState::Command;
+    g_nowUs = 0;
+    g_rand = 1;
+    g_serialIn = "";
+    g_capture = nullptr;
+    resetStats();
+}
+
+void MockBus::resetStats()
+{
+    memset(&g_stats, 0, sizeof(g_stats));
+}
+
+const MockBusStats &MockBus::stats()
+{
+    return g_stats;
+}
+
+uint32_t MockBus::estimatedAvrMicros()
+{
+    const uint64_t x10 =
+        (uint64_t)g_stats.bytesOut * MOCK_AVR_US_PER_BYTE_X10 +
+        (uint64_t)g_stats.csToggles * MOCK_AVR_US_PER_CS_X10 +
+        (uint64_t)g_stats.transactions * MOCK_AVR_US_PER_TXN_X10;
+    return (uint32_t)(x10 / 10u);
+}
+
+uint8_t MockBus::chipRegister(uint8_t csPin, uint8_t page, uint16_t reg)
+{
+    const Chip *c = findChip(csPin, false);
+    if (!c || page >= MOCK_PAGES || reg >= MOCK_PAGE_SIZE)
+        return 0;
+    return c->regs[page][reg];
+}
+
+void MockBus::captureOutput(uint8_t *buf, uint32_t size)
+{
+    g_capture = buf;
+    g_captureSize = size;
+    g_captureLen = 0;
+}
+
+uint32_t MockBus::capturedLength()
+{
+    return g_captureLen;
+}
+
+void MockBus::onPinWrite(uint8_t pin, uint8_t level)
+{
+    level = level ? HIGH : LOW;
+    if (g_pinLevel[pin] == level)
+        return;
+    g_pinLevel[pin] = level;
+
+    // Only lines configured as outputs with a chip behind them are CS lines;
+    // the first LOW edge on a new output pin creates its chip.
+    if (!g_pinIsOutput[pin])
+        return;
+    if (level == LOW)
+        findChip(pin, true);
+    if (!findChip(pin, false))
+        return;
+
+    g_stats.csToggles++;
+    if (level == LOW)
+    {
+        g_state = FrameState::Command;
+    }
+    else
+    {
+        g_stats.frames++;
+        if (g_read)
+            g_stats.readFrames++;
+        g_read = false;
+    }
+}
+
+void MockBus::onBeginTransaction()
+{
+    g_stats.transactions++;
+}
+
+void MockBus::onEndTransaction()
+{
+}
+
+uint8_t MockBus::onTransfer(uint8_t out)
+{
+    g_stats.bytesOut++;
+    if (g_capture != nullptr)
+    {
+        if (g_captureLen < g_captureSize)
+            g_capture[g_captureLen] = out;
+        g_captureLen++;
+    }
+
+    uint8_t in = 0;
+    switch (g_state)
+    {
+    case FrameState::Command:
+        g_page = (uint8_t)((out >> 1) & 0x07);
+        g_read = (out & 0x01) != 0;
+        g_state = FrameState::Address;
+        break;
+
+    case FrameState::Address:
+        g_addr = out;
+        g_state = FrameState::Data;
+        break;
+
+    case FrameState::Data:
+        for (Chip &c : g_chips)
+        {
+            if (!isSelected(c))
+                continue;
+            if (g_read)
+                in = (g_page < MOCK_PAGES && g_addr < MOCK_PAGE_SIZE) ? c.regs[g_page][g_addr] : 0;
+            else
+                chipWrite(c, g_page, g_addr, out);
+        }
+        if (!g_read && g_page < MOCK_PAGES)
+            g_stats.pageBytes[g_page]++;
+        g_addr++;
+        break;
+    }
+    return in;
+}
+
+uint64_t MockBus::nowMicros()
+{
+    return g_nowUs;
+}
+
+void MockBus::advanceMicros(uint64_t us)
+{
+    g_nowUs += us;
+}
+
+void MockBus::setSerialInput(const char *text)
+{
+    g_serialIn = text ? text : "";
+}
+
+//******************************************************** */
+// Arduino core
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    g_pinIsOutput[pin] = (mode == OUTPUT);
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    MockBus::onPinWrite(pin, val);
+}
+
+int digitalRead(uint8_t pin)
+{
+    return g_pinLevel[pin];
+}
+
+int analogRead(uint8_t pin)
+{
+    return (int)((pin * 37u + (uint32_t)(g_nowUs / 1000u) * 13u) & 0x3FFu);
+}
+
+unsigned long millis()
+{
+    return (unsigned long)(g_nowUs / 1000u);
+}
+
+unsigned long micros()
+{
+    return (unsigned long)g_nowUs;
+}
+
+void delay(unsigned long ms)
+{
+    g_nowUs += (uint64_t)ms * 1000u;
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    g_nowUs += us;
+}
+
+long random(long howbig)
+{
+    if (howbig <= 0)
+        return 0;
+    // Deterministic LCG so benchmark runs are reproducible.
+    g_rand = g_rand * 1103515245u + 12345u;
+    return (long)((g_rand >> 16) % (uint32_t)howbig);
+}
+
+long random(long howsmall, long howbig)
+{
+    if (howsmall >= howbig)
+        return howsmall;
+    return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long)
+{
+    // Ignored: the seed is pinned by MockBus::reset() for reproducibility.
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+//******************************************************** */
+// Serial: output is discarded, input comes from MockBus::setSerialInput().
+
+int HardwareSerial::available()
+{
+    return (int)strlen(g_serialIn);
+}
+
+int HardwareSerial::read()
+{
+    if (!*g_serialIn)
+        return -1;
+    return (uint8_t)*g_serialIn++;
+}
+
+size_t HardwareSerial::write(uint8_t)
+{
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *, size_t len)
+{
+    return len;
+}
+
+size_t HardwareSerial::print(const char *s)
+{
+    return strlen(s);
+}
+
+size_t HardwareSerial::print(char)
+{
+    return 1;
+}
+
+size_t HardwareSerial::print(long v, int)
+{
+    char buf[24];
+    return (size_t)snprintf(buf, sizeof(buf), "%ld", v);
+}
+
+size_t HardwareSerial::print(unsigned long v, int)
+{
+    char buf[24];
+    return (size_t)snprintf(buf, sizeof(buf), "%lu", v);
+}
+
+size_t HardwareSerial::print(double v, int digits)
+{
+    char buf[48];
+    return (size_t)snprintf(buf, sizeof(buf), "%.*f", digits, v);
+}
+
+size_t HardwareSerial::printf(const char *fmt, ...)
+{
+    char buf[128];
+    va_list ap;
+    va_start(ap, fmt);
+    const int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    return n > 0 ? (size_t)n : 0;
+}
+
+//******************************************************** */
+// SPI
+
+void SPIClass::beginTransaction(SPISettings)
+{
+    MockBus::onBeginTransaction();
+}
+
+void SPIClass::endTransaction()
+{
+    MockBus::onEndTransaction();
+}
+
+uint8_t SPIClass::transfer(uint8_t data)
+{
+    return MockBus::onTransfer(data);
+}
+
+void SPIClass::transfer(void *buf, size_t count)
+{
+    uint8_t *p = (uint8_t *)buf;
+    while (count--)
+    {
+        *p = MockBus::onTransfer(*p);
+        p++;
+    }
+}
+
+void SPIClass::writeBytes(const uint8_t *data, uint32_t size)
+{
+    while (size--)
+        MockBus::onTransfer(*data++);
+}
+
+void SPIClass::transfer(const void *txbuf, void *rxbuf, size_t count, bool block)
+{
+    const uint8_t *tx = (const uint8_t *)txbuf;
+    uint8_t *rx = (uint8_t *)rxbuf;
+    while (count--)
+    {
+        const uint8_t in = MockBus::onTransfer(tx ? *tx++ : 0xFF);
+        if (rx)
+            *rx++ = in;
+    }
+    _dmaBusy = !block;
+}
+
+bool SPIClass::isBusy()
+{
+    // Report busy once, then done: enough to exercise the polling path.
+    const bool busy = _dmaBusy;
+    _dmaBusy = false;
+    return busy;
+}
+
+void SPIClass::waitForTransfer()
+{
+    _dmaBusy = false;
+}
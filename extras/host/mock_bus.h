@@ -0,0 +1,69 @@
+// Recorder behind the host Arduino/SPI stand-ins.
+//
+// MockBus counts everything the driver puts on the wire and emulates the
+// register file of one AW20216S per CS pin, so reads (begin() check,
+// read-modify-write paths) return what was written earlier.
+#ifndef AW_HOST_MOCK_BUS_H
+#define AW_HOST_MOCK_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Register space per emulated chip: Page 4 spans 432 addresses.
+#define MOCK_PAGES      5
+#define MOCK_PAGE_SIZE  512
+#define MOCK_MAX_CHIPS  16
+
+// Wire counters. All values are totals since the last MockBus::reset().
+struct MockBusStats
+{
+    uint32_t bytesOut;      // Bytes clocked out on MOSI (commands included)
+    uint32_t transactions;  // beginTransaction() calls
+    uint32_t csToggles;     // Edges on any chip-select line
+    uint32_t frames;        // CS-low..CS-high windows
+    uint32_t pageBytes[MOCK_PAGES]; // Data bytes written per page
+    uint32_t readFrames;    // Frames that carried a read command
+};
+
+// Rough cost model for an 8 MHz AVR (Uno-class) board, in microseconds.
+// SPI shifts one byte in 1 us at F_CPU/2; the driver's byte loop, a CS
+// edge and a begin/endTransaction pair add the fixed overheads.
+#define MOCK_AVR_US_PER_BYTE_X10   15  // 1.5 us per byte (shift + loop)
+#define MOCK_AVR_US_PER_CS_X10     5   // 0.5 us per CS edge (AwFastPin port write)
+#define MOCK_AVR_US_PER_TXN_X10    30  // 3.0 us per transaction pair
+
+namespace MockBus
+{
+    // Clear counters and emulated chips, rewind the virtual clock.
+    void reset();
+    // Clear counters only.
+    void resetStats();
+    const MockBusStats &stats();
+
+    // Estimated bus time on an AVR for the current counters.
+    uint32_t estimatedAvrMicros();
+
+    // Emulated register of the chip selected by csPin (created on demand).
+    uint8_t chipRegister(uint8_t csPin, uint8_t page, uint16_t reg);
+
+    // Copy every MOSI byte into buf (at most size) from now on; nullptr
+    // stops. reset() stops it too. capturedLength() counts all bytes seen,
+    // including those past size.
+    void captureOutput(uint8_t *buf, uint32_t size);
+    uint32_t capturedLength();
+
+    // Hooks used by the Arduino/SPI stand-ins.
+    void onPinWrite(uint8_t pin, uint8_t level);
+    void onBeginTransaction();
+    void onEndTransaction();
+    uint8_t onTransfer(uint8_t out);
+
+    // Virtual clock in microseconds.
+    uint64_t nowMicros();
+    void advanceMicros(uint64_t us);
+
+    // Bytes returned by Serial.read() (consumed in order).
+    void setSerialInput(const char *text);
+}
+
+#endif // AW_HOST_MOCK_BUS_H
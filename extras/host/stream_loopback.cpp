@@ -0,0 +1,207 @@
+// Loopback harness for the frame-streaming protocol.
+//
+// The host encoder (extras/stream/aw_stream_encoder.h) and the on-target
+// receiver (AW20216SStream) talk over a simulated 921600 baud link; the
+// receiver drives mock chips. For every ACK the chips' Page 1 must hold
+// exactly the frame that was sent. Replies reach the sender a few frames
+// late, as over a real link, and some frames are corrupted on the wire so
+// the NAK / keyframe recovery runs too. The run fails if a shown frame is
+// wrong, if the link cannot carry the content at AWS_TARGET_FPS, or if
+// the stream does not recover.
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "AW20216SStream.h"
+#include "aw_stream_encoder.h"
+#include "mock_bus.h"
+
+#define AWS_BAUD        921600u
+#define AWS_BYTES_PER_S (AWS_BAUD / 10u) // 8N1
+#define AWS_TARGET_FPS  60u
+#define AWS_ACK_LAG     3u               // Frames in flight before a reply is seen
+#define AWS_FRAMES      240u
+#define AWS_CS_BASE     10u
+#define AWS_ROWS        12u
+#define AWS_FRAME_BYTES AW_FRAME_SIZE(AWS_ROWS)
+
+// Serial stand-in fed from a byte buffer; replies are collected.
+struct LinkIo
+{
+    const uint8_t *data;
+    size_t len;
+    std::vector<uint8_t> replies;
+
+    int available() const { return (int)len; }
+    int read()
+    {
+        len--;
+        return *data++;
+    }
+    size_t write(const uint8_t *buf, size_t n)
+    {
+        replies.insert(replies.end(), buf, buf + n);
+        return n;
+    }
+};
+
+enum class Content
+{
+    Gradient, // Smooth motion: mostly deltas
+    Noise,    // Every byte changes: full frames only (worst case)
+    Sparse    // A few moving pixels on black
+};
+
+static void render(Content kind, unsigned chip, unsigned frame, uint8_t *out)
+{
+    for (unsigned i = 0; i < AWS_FRAME_BYTES; i++)
+    {
+        switch (kind)
+        {
+        case Content::Gradient:
+            out[i] = (uint8_t)(i * 3u + frame * 5u + chip * 40u);
+            break;
+        case Content::Noise:
+            out[i] = (uint8_t)(random(256));
+            break;
+        case Content::Sparse:
+            out[i] = ((i / 3u) % 72u == (frame + chip * 7u) % 72u) ? 0xC0 : 0x00;
+            break;
+        }
+    }
+}
+
+static const char *contentName(Content kind)
+{
+    return kind == Content::Gradient ? "gradient" : kind == Content::Noise ? "noise" : "sparse";
+}
+
+// Stream AWS_FRAMES frames to `chips` panels. corruptEvery > 0 flips one
+// byte of every n-th frame on the wire. Returns false on any failure.
+static bool run(unsigned chips, Content kind, unsigned corruptEvery)
+{
+    MockBus::reset();
+    randomSeed(chips * 31u + (unsigned)kind);
+
+    std::vector<AW20216S *> panels;
+    std::vector<AW20216SBase *> drivers;
+    for (unsigned c = 0; c < chips; c++)
+    {
+        panels.push_back(new AW20216S(AWS_ROWS, 6, (uint8_t)(AWS_CS_BASE + c)));
+        panels.back()->begin();
+        drivers.push_back(panels.back());
+    }
+    AW20216SStream rx(drivers.data(), (uint8_t)chips);
+    AwStreamEncoder tx(chips, AWS_FRAME_BYTES);
+
+    // Frames by sequence number, to check what the chips show.
+    std::vector<std::vector<uint8_t>> sent(256, std::vector<uint8_t>(chips * AWS_FRAME_BYTES));
+    std::vector<int> answered(256, 0); // 0 none, 1 ack, 2 nak
+    std::vector<uint8_t> pendingSeq;   // Sent, reply not seen by the sender yet
+
+    unsigned long wireBytes = 0, bad = 0, acks = 0, naks = 0, timeouts = 0;
+    std::vector<uint8_t> wire;
+    std::vector<const uint8_t *> ptrs(chips);
+
+    for (unsigned f = 0; f < AWS_FRAMES; f++)
+    {
+        // The sender sees replies AWS_ACK_LAG frames late.
+        while (pendingSeq.size() > AWS_ACK_LAG)
+        {
+            const uint8_t s = pendingSeq.front();
+            pendingSeq.erase(pendingSeq.begin());
+            if (answered[s] == 1)
+                continue;
+            if (answered[s] == 2)
+                naks++;
+            else
+                timeouts++;
+            tx.forceKeyframe();
+        }
+
+        std::vector<uint8_t> content(chips * AWS_FRAME_BYTES);
+        for (unsigned c = 0; c < chips; c++)
+        {
+            render(kind, c, f, &content[c * AWS_FRAME_BYTES]);
+            ptrs[c] = &content[c * AWS_FRAME_BYTES];
+        }
+
+        wire.clear();
+        const uint8_t seq = tx.encodeFrame(ptrs.data(), wire);
+        sent[seq] = content;
+        answered[seq] = 0;
+        pendingSeq.push_back(seq);
+        wireBytes += wire.size();
+
+        if (corruptEvery && f % corruptEvery == corruptEvery - 1u)
+        {
+            const size_t at = (size_t)random((long)wire.size() - 1);
+            wire[at] ^= (uint8_t)(1u + random(255)); // Never a no-op
+        }
+
+        LinkIo io = {wire.data(), wire.size(), std::vector<uint8_t>()};
+        rx.poll(io);
+
+        for (size_t i = 0; i + 1 < io.replies.size(); i += 2)
+        {
+            const uint8_t s = io.replies[i + 1];
+            if (io.replies[i] != AWS_ACK)
+            {
+                answered[s] = 2;
+                continue;
+            }
+
+            answered[s] = 1;
+            acks++;
+            for (unsigned c = 0; c < chips; c++)
+            {
+                for (unsigned r = 0; r < AWS_FRAME_BYTES; r++)
+                {
+                    if (MockBus::chipRegister((uint8_t)(AWS_CS_BASE + c), 1, (uint8_t)r) !=
+                        sent[s][c * AWS_FRAME_BYTES + r])
+                    {
+                        bad++;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    const double perFrame = (double)wireBytes / AWS_FRAMES;
+    const double maxFps = AWS_BYTES_PER_S / perFrame;
+    printf("stream/%uchips/%s%s: %.0f bytes/frame, %.1f fps max at %u baud, "
+           "%lu shown, %lu nak, %lu lost, %lu rx errors, %lu wrong\n",
+           chips, contentName(kind), corruptEvery ? "+errors" : "", perFrame, maxFps, AWS_BAUD,
+           acks, naks, timeouts, (unsigned long)rx.errors(), bad);
+
+    bool ok = (bad == 0) && (maxFps >= AWS_TARGET_FPS);
+    if (corruptEvery == 0)
+        ok = ok && acks == AWS_FRAMES && rx.errors() == 0;
+    else
+        ok = ok && acks >= AWS_FRAMES / 2u && rx.errors() > 0;
+
+    for (unsigned c = 0; c < chips; c++)
+        delete panels[c];
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    ok &= run(1, Content::Noise, 0);
+    ok &= run(4, Content::Gradient, 0);
+    ok &= run(4, Content::Sparse, 0);
+    ok &= run(6, Content::Noise, 0);
+    ok &= run(4, Content::Gradient, 17);
+    ok &= run(6, Content::Sparse, 23);
+
+    if (!ok)
+    {
+        fprintf(stderr, "stream loopback FAILED\n");
+        return 1;
+    }
+    printf("stream loopback OK\n");
+    return 0;
+}
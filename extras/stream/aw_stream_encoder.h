@@ -0,0 +1,163 @@
+// Host-side encoder for the AW20216SStream protocol (see src/AW20216SStream.h).
+//
+// Header-only, standard C++11: used by the serial sender (aw_stream_send.cpp)
+// and by the loopback harness in extras/host. Frames are the driver's
+// framebuffer layout: rows x 18 bytes, i.e. rgb24 rows of 6 pixels.
+#ifndef AW_STREAM_ENCODER_H
+#define AW_STREAM_ENCODER_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+// Must match src/AW20216SStream.h.
+#define AWS_FULL  0x01
+#define AWS_DELTA 0x02
+#define AWS_SHOW  0x03
+#define AWS_ACK   0x06
+#define AWS_NAK   0x15
+
+// Unchanged bytes a delta run swallows instead of opening a new run
+// (a run header costs 2 bytes).
+#define AWS_DELTA_MERGE_GAP 2
+
+class AwStreamEncoder
+{
+public:
+    // chips panels of frameBytes bytes each (18 x rows).
+    AwStreamEncoder(unsigned chips, unsigned frameBytes)
+        : _frameBytes(frameBytes), _prev(chips, std::vector<uint8_t>(frameBytes, 0)),
+          _known(chips, false), _seq(0)
+    {
+    }
+
+    // Next frame goes out as full frames for every chip (after a NAK, an
+    // ack timeout, or a receiver reset).
+    void forceKeyframe()
+    {
+        for (size_t i = 0; i < _known.size(); i++)
+            _known[i] = false;
+    }
+
+    // Append one frame to `out`: a full or delta packet per chip (whichever
+    // is shorter) and a show packet. frames[i] points to chip i's bytes.
+    // Returns the sequence number of the show packet.
+    uint8_t encodeFrame(const uint8_t *const *frames, std::vector<uint8_t> &out)
+    {
+        const uint8_t seq = _seq++;
+        std::vector<uint8_t> pkt;
+
+        for (unsigned c = 0; c < _prev.size(); c++)
+        {
+            const uint8_t *cur = frames[c];
+            std::vector<uint8_t> &prev = _prev[c];
+
+            pkt.clear();
+            pkt.push_back(AWS_DELTA);
+            pkt.push_back(seq);
+            pkt.push_back((uint8_t)c);
+            if (_known[c])
+                _appendRuns(prev.data(), cur, pkt);
+
+            if (!_known[c] || pkt.size() >= 3u + _frameBytes)
+            {
+                pkt.resize(3);
+                pkt[0] = AWS_FULL;
+                pkt.insert(pkt.end(), cur, cur + _frameBytes);
+            }
+
+            if (pkt[0] == AWS_FULL || pkt.size() > 3u)
+                appendPacket(pkt, out);
+
+            memcpy(prev.data(), cur, _frameBytes);
+            _known[c] = true;
+        }
+
+        pkt.clear();
+        pkt.push_back(AWS_SHOW);
+        pkt.push_back(seq);
+        appendPacket(pkt, out);
+        return seq;
+    }
+
+    // CRC-8, poly 0x07, initial 0.
+    static uint8_t crc8(const uint8_t *p, size_t n)
+    {
+        uint8_t crc = 0;
+        while (n--)
+        {
+            crc ^= *p++;
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc & 0x80u) ? (uint8_t)((crc << 1) ^ 0x07u) : (uint8_t)(crc << 1);
+        }
+        return crc;
+    }
+
+    // COBS-encode pkt + its CRC and append it with the 0x00 delimiter.
+    static void appendPacket(const std::vector<uint8_t> &pkt, std::vector<uint8_t> &out)
+    {
+        std::vector<uint8_t> raw(pkt);
+        raw.push_back(crc8(pkt.data(), pkt.size()));
+
+        size_t codeAt = out.size();
+        out.push_back(0); // Code byte, patched below
+        uint8_t code = 1;
+        for (size_t i = 0; i < raw.size(); i++)
+        {
+            if (raw[i] == 0)
+            {
+                out[codeAt] = code;
+                codeAt = out.size();
+                out.push_back(0);
+                code = 1;
+                continue;
+            }
+            out.push_back(raw[i]);
+            if (++code == 0xFF)
+            {
+                out[codeAt] = code;
+                codeAt = out.size();
+                out.push_back(0);
+                code = 1;
+            }
+        }
+        out[codeAt] = code;
+        out.push_back(0);
+    }
+
+private:
+    unsigned _frameBytes;
+    std::vector<std::vector<uint8_t>> _prev; // Last frame sent per chip
+    std::vector<bool> _known;                // Receiver holds _prev[c]
+    uint8_t _seq;
+
+    // Runs of changed bytes: { start, len, bytes }, merging short gaps.
+    void _appendRuns(const uint8_t *prev, const uint8_t *cur, std::vector<uint8_t> &pkt) const
+    {
+        unsigned i = 0;
+        while (i < _frameBytes)
+        {
+            if (prev[i] == cur[i])
+            {
+                i++;
+                continue;
+            }
+
+            const unsigned start = i;
+            unsigned end = i;
+            for (i = start + 1; i < _frameBytes && i - end <= AWS_DELTA_MERGE_GAP + 1u && i - start < 255u; i++)
+            {
+                if (prev[i] != cur[i])
+                    end = i;
+            }
+
+            pkt.push_back((uint8_t)start);
+            pkt.push_back((uint8_t)(end - start + 1u));
+            pkt.insert(pkt.end(), cur + start, cur + end + 1u);
+            i = end + 1u;
+        }
+    }
+};
+
+#endif // AW_STREAM_ENCODER_H
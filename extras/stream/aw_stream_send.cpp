@@ -0,0 +1,246 @@
+// Stream raw video to AW20216S panels over a serial port.
+//
+//   aw_stream_send <port> <chips> [fps] [baud]
+//
+// Reads frames from stdin: rgb24, 6 pixels wide, chips x 12 rows high
+// (chip 0 on top), i.e. each chip's rows are exactly its framebuffer. For
+// example, with ffmpeg:
+//
+//   ffmpeg -re -i clip.mp4 -vf scale=6:48 -f rawvideo -pix_fmt rgb24 - |
+//       ./aw_stream_send /dev/ttyUSB0 4 60
+//
+// Each frame goes out as full or delta packets plus a show packet (see
+// aw_stream_encoder.h). At most AWS_WINDOW frames are in flight: the
+// sender waits for the receiver's ACKs, and sends full frames again after
+// a NAK or when a reply is overdue. POSIX (Linux / macOS).
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <deque>
+#include <vector>
+
+#include "aw_stream_encoder.h"
+
+#define AWS_ROWS        12u
+#define AWS_WINDOW      3u   // Frames sent but not acknowledged
+#define AWS_TIMEOUT_MS  250u // Reply overdue: resync with full frames
+#define AWS_REPORT_MS   5000u
+
+static uint64_t nowMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
+
+static speed_t baudConstant(long baud)
+{
+    switch (baud)
+    {
+    case 115200: return B115200;
+    case 230400: return B230400;
+#ifdef B460800
+    case 460800: return B460800;
+#endif
+#ifdef B921600
+    case 921600: return B921600;
+#endif
+#ifdef B1000000
+    case 1000000: return B1000000;
+#endif
+#ifdef B2000000
+    case 2000000: return B2000000;
+#endif
+    default: return 0;
+    }
+}
+
+static int openPort(const char *path, long baud)
+{
+    const speed_t speed = baudConstant(baud);
+    if (speed == 0)
+    {
+        fprintf(stderr, "unsupported baud rate %ld on this system\n", baud);
+        return -1;
+    }
+
+    const int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0)
+    {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    struct termios tio;
+    tcgetattr(fd, &tio);
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    tcsetattr(fd, TCSANOW, &tio);
+    tcflush(fd, TCIOFLUSH);
+    return fd;
+}
+
+static bool writeAll(int fd, const uint8_t *p, size_t n)
+{
+    while (n)
+    {
+        const ssize_t w = write(fd, p, n);
+        if (w < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+                continue;
+            return false;
+        }
+        p += w;
+        n -= (size_t)w;
+    }
+    return true;
+}
+
+static bool readFrame(uint8_t *buf, size_t n)
+{
+    while (n)
+    {
+        const size_t r = fread(buf, 1, n, stdin);
+        if (r == 0)
+            return false;
+        buf += r;
+        n -= r;
+    }
+    return true;
+}
+
+struct InFlight
+{
+    uint8_t seq;
+    uint64_t sentMs;
+};
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s <port> <chips> [fps=60] [baud=921600]\n", argv[0]);
+        return 2;
+    }
+
+    const unsigned chips = (unsigned)atoi(argv[2]);
+    const unsigned fps = (argc > 3) ? (unsigned)atoi(argv[3]) : 60u;
+    const long baud = (argc > 4) ? atol(argv[4]) : 921600L;
+    if (chips == 0 || chips > 16 || fps == 0)
+    {
+        fprintf(stderr, "chips must be 1-16 and fps > 0\n");
+        return 2;
+    }
+
+    const int fd = openPort(argv[1], baud);
+    if (fd < 0)
+        return 1;
+
+    const size_t chipBytes = AWS_ROWS * 18u;
+    std::vector<uint8_t> frame(chips * chipBytes);
+    std::vector<const uint8_t *> ptrs(chips);
+    for (unsigned c = 0; c < chips; c++)
+        ptrs[c] = &frame[c * chipBytes];
+
+    AwStreamEncoder tx(chips, (unsigned)chipBytes);
+    std::deque<InFlight> inFlight;
+    std::vector<uint8_t> wire, reply;
+
+    const uint8_t sync = 0x00; // Ends whatever the receiver was decoding
+    writeAll(fd, &sync, 1);
+
+    unsigned long frames = 0, bytes = 0, acks = 0, naks = 0, timeouts = 0;
+    uint64_t nextMs = nowMs(), reportMs = nextMs + AWS_REPORT_MS;
+
+    while (readFrame(frame.data(), frame.size()))
+    {
+        // Wait for a window slot, handling replies as they come.
+        for (;;)
+        {
+            uint8_t in[64];
+            const ssize_t r = read(fd, in, sizeof(in));
+            if (r > 0)
+                reply.insert(reply.end(), in, in + r);
+
+            while (reply.size() >= 2)
+            {
+                const uint8_t code = reply[0], seq = reply[1];
+                reply.erase(reply.begin(), reply.begin() + 2);
+
+                // Replies come in order: anything older was lost.
+                while (!inFlight.empty() && inFlight.front().seq != seq)
+                {
+                    inFlight.pop_front();
+                    timeouts++;
+                    tx.forceKeyframe();
+                }
+                if (!inFlight.empty())
+                    inFlight.pop_front();
+
+                if (code == AWS_ACK)
+                    acks++;
+                else
+                {
+                    naks++;
+                    tx.forceKeyframe();
+                }
+            }
+
+            if (!inFlight.empty() && nowMs() - inFlight.front().sentMs > AWS_TIMEOUT_MS)
+            {
+                inFlight.clear();
+                reply.clear();
+                timeouts++;
+                tx.forceKeyframe();
+                writeAll(fd, &sync, 1);
+            }
+
+            if (inFlight.size() < AWS_WINDOW)
+                break;
+
+            struct pollfd pfd = {fd, POLLIN, 0};
+            poll(&pfd, 1, 2);
+        }
+
+        wire.clear();
+        const uint8_t seq = tx.encodeFrame(ptrs.data(), wire);
+        if (!writeAll(fd, wire.data(), wire.size()))
+        {
+            fprintf(stderr, "write failed: %s\n", strerror(errno));
+            return 1;
+        }
+        inFlight.push_back(InFlight{seq, nowMs()});
+        frames++;
+        bytes += wire.size();
+
+        // Pace to the requested frame rate.
+        nextMs += 1000u / fps;
+        const uint64_t t = nowMs();
+        if (nextMs > t)
+            usleep((useconds_t)((nextMs - t) * 1000u));
+        else if (t - nextMs > 1000u)
+            nextMs = t; // Far behind (slow input): do not burst
+
+        if (t >= reportMs)
+        {
+            fprintf(stderr, "frames=%lu acked=%lu nak=%lu lost=%lu bytes/frame=%lu\n",
+                    frames, acks, naks, timeouts, frames ? bytes / frames : 0ul);
+            reportMs = t + AWS_REPORT_MS;
+        }
+    }
+
+    close(fd);
+    return 0;
+}
@@ -1,55 +1,164 @@
 #include "AW20216S.h"
-
-// Definitions of times (Datasheet Page 7 & 9)
-#define AW_RESET_DELAY 2 // 2ms delay after reset [cite: 524]
+#include "AW20216SColorLut.h" // aw_lut_detail::MakeSeq for the split table
 
 //******************************************************** */
 
 /**
- * @brief Construct the driver and cache its configuration.
+ * @brief Construct the driver on caller-provided storage.
  * 
- * @param rows    Number of rows (SWy lines), 1-12.
+ * @param rows    Number of rows (SWy lines), 1 - maxRows.
  * @param cols    Number of columns (RGB triplets), 1-6.
  * @param csPin   MCU GPIO used as Chip Select (active LOW).
  * @param spiPort SPI bus instance driving the chip.
+ * @param storage AW_DRIVER_RAM(maxRows) bytes.
+ * @param maxRows Rows the storage is sized for, 1-12.
+ * @param frame   Shared scratch frame for a frameless driver, or nullptr.
  */
-AW20216S::AW20216S(uint8_t rows, uint8_t cols, uint8_t csPin, SPIClass &spiPort)
+AW20216SBase::AW20216SBase(uint8_t rows, uint8_t cols, uint8_t csPin, SPIClass &spiPort,
+                           uint8_t *storage, uint8_t maxRows, uint8_t *frame)
 {
+    _maxRows = (maxRows == 0 || maxRows > AW_MAX_ROWS) ? AW_MAX_ROWS : maxRows;
+    _frameSize = AW_BASE_Y(_maxRows);
     _csPin = csPin;
-    _rows = rows;
+    _rows = (rows == 0 || rows > _maxRows) ? _maxRows : rows;
     _cols = cols;
     _spiPort = &spiPort;
-    _currentPage = 0xFF; // Invalid value to force update
+    _transport = nullptr;
+
+    // Carve the storage block in the order AW_DRIVER_RAM() counts it.
+    if (frame != nullptr)
+    {
+        // Indexed-only driver: RGB drawing lands in a scratch frame that is
+        // never sent, so both roles share it.
+        _frameBuffer = frame;
+        _chipShadow = frame;
+    }
+    else
+    {
+        _frameBuffer = storage;
+        _chipShadow = storage + _frameSize;
+        storage += 2u * _frameSize;
+    }
+    _patterns = storage;
+    storage = _patterns + _patternRegs();
+#if AW_ENABLE_SCALING_BUFFER
+    // Indexed-only drivers have no scaling buffer: setScaling() streams the
+    // triplet and the per-pixel scaling calls do nothing.
+    _scaling = nullptr;
+    if (frame == nullptr)
+    {
+        _scaling = storage;
+        storage += _frameSize;
+    }
+#endif
+#if AW_NEEDS_SPI_SCRATCH
+    _spiScratch = storage;
+#endif
+
+    _asyncBusy = false;
+    _outputLut = nullptr;
+    _viewport = nullptr;
+    _viewCols = 0;
+    _viewX = 0;
+    _indexed = nullptr;
+    _palette = nullptr;
+    _paletteSize = 0;
+    _indexBpp = 8;
     _clearFrameBuffer();
+    _shadowValid = false; // Chip content unknown until reset()/show()
+    _markClean();
+#if AW_ENABLE_SCALING_BUFFER
+    if (_scaling != nullptr)
+        memset(_scaling, 0xFF, _frameSize); // No attenuation until told otherwise
+#endif
+    memset(_patterns, 0, _patternRegs()); // Power-on default: all direct PWM
+    _patDirtyLo = 0xFF;
+    _patDirtyHi = 0x00;
+    _faultMap = nullptr;
+    _faultMode = 0;
+    _faultReg = 0;
+    _faultT0 = 0;
+    _seedPage0Defaults();
+#if AW_ENABLE_STATS
+    resetStats();
+    _txStartUs = 0;
+#endif
 }
 
 //******************************************************** */
 
 /**
- * @brief Start SPI, reset, enable the chip and set a default current.
+ * @brief Start SPI (or the transport), reset, enable the chip and set a
+ *        default current.
  * 
  * @return true if the GCR register reads back as expected, false otherwise.
  */
-bool AW20216S::begin()
+bool AW20216SBase::begin()
 {
-    pinMode(_csPin, OUTPUT);
-    digitalWrite(_csPin, HIGH);
+    _beginBus();
     delay(20); // Small delay to ensure proper startup
-    _spiPort->begin();
 
     // 1. Reset the chip via software to ensure a clean state [cite: 522]
     this->reset();
     // 2. Chip Enable [cite: 530]
     // GCR register (0x00), Bit 0 (CHIPEN) = 1
-    // Bit 4-7 (SWSEL) The default is 1011 (12 active rows), so we'll leave it like that.
-    writeRegister(AW20216S_PAGE0, AW_REG_GCR, 0xB1); // 1011 0001
+    // Bit 4-7 (SWSEL) = rows - 1: only scan the populated SW lines, so each
+    // row gets a bigger share of the TDM cycle (0xB1 for 12 rows).
+    const uint8_t gcrExpected = (uint8_t)(AW_GCR_SWSEL(_rows) | AW_GLOBAL_ENABLE);
+    writeRegister(AW20216S_PAGE0, AW_REG_GCR, gcrExpected);
 
     // 3. Set global current to the maximum by default (or a safe value) [cite: 9]
     setGlobalCurrent(0x80); // 128/255 (~50% global current)
 
     // Simple verification: Read the GCR register to see if it saved the value
     uint8_t gcr = readRegister(AW20216S_PAGE0, AW_REG_GCR);
-    return (gcr == 0xB1);
+    return (gcr == gcrExpected);
+}
+
+/**
+ * @brief Set up CS and the SPI port, or the transport (CS left inactive).
+ */
+void AW20216SBase::_beginBus()
+{
+    if (_transport != nullptr)
+    {
+        _transport->begin();
+        return;
+    }
+
+    _cs.begin(_csPin, OUTPUT);
+    _cs.high();
+    _spiPort->begin();
+}
+
+//******************************************************** */
+
+/**
+ * @brief Set the number of scanned rows (GCR SWSEL) and the drawing bounds.
+ * 
+ * @param rows Active rows, 1 - maxRows (clamped).
+ */
+void AW20216SBase::setActiveRows(uint8_t rows)
+{
+    if (rows == 0)
+        rows = 1;
+    if (rows > _maxRows)
+        rows = _maxRows;
+
+    // Rows that leave the scan are blanked so they come back dark.
+    if (rows < _rows)
+    {
+        const uint8_t lo = AW_BASE_Y(rows);
+        const uint8_t hi = (uint8_t)(AW_BASE_Y(_rows) - 1u);
+        memset(&_frameBuffer[lo], 0, (size_t)(hi - lo + 1u));
+        _markDirty(lo, hi);
+    }
+    _rows = rows;
+
+    // Read-modify-write from the Page 0 copy: keep CHIPEN and the rest.
+    const uint8_t gcr = (uint8_t)((_readPage0(AW_REG_GCR) & ~AW_GCR_SWSEL_MASK) |
+                                  AW_GCR_SWSEL(rows));
+    writeRegister(AW20216S_PAGE0, AW_REG_GCR, gcr);
 }
 
 //******************************************************** */
@@ -57,10 +166,40 @@ bool AW20216S::begin()
 /**
  * @brief Software reset (writes 0xAE to RSTN) and wait for OTP reload.
  */
-void AW20216S::reset()
+void AW20216SBase::reset()
 {
     writeRegister(AW20216S_PAGE0, AW_REG_RSTN, AW_RST_CMD);
     delay(AW_RESET_DELAY); // Wait for OTP loading time [cite: 507]
+    _afterReset();
+}
+
+/**
+ * @brief Bring the RAM copies back to the chip's power-on state.
+ */
+void AW20216SBase::_afterReset()
+{
+    // Function registers are back at their power-on values (detection off).
+    _seedPage0Defaults();
+    _faultMap = nullptr;
+
+    // All PWM registers power up at 0: the next show() only sends what the
+    // framebuffer lights up.
+    memset(_chipShadow, 0, _frameSize);
+    _shadowValid = true;
+    _markDirty(0, (uint8_t)(_frameSize - 1u));
+
+    // Page 3 is back to "all channels on direct PWM"; keep pending
+    // assignments so commitPatterns() re-sends them.
+    for (uint8_t reg = 0; reg < _patternRegs(); reg++)
+    {
+        if (_patterns[reg] != 0)
+        {
+            if (reg < _patDirtyLo)
+                _patDirtyLo = reg;
+            if (reg > _patDirtyHi)
+                _patDirtyHi = reg;
+        }
+    }
 }
 
 //******************************************************** */
@@ -68,9 +207,10 @@ void AW20216S::reset()
 /**
  * @brief Clear the framebuffer (all pixels off). Call show() to apply.
  */
-void AW20216S::clearScreen()
+void AW20216SBase::clearScreen()
 {
     _clearFrameBuffer();
+    _markDirty(0, (uint8_t)(_frameSize - 1u));
 }
 
 //******************************************************** */
@@ -82,14 +222,29 @@ void AW20216S::clearScreen()
  * @param g Green PWM value, 0-255.
  * @param b Blue  PWM value, 0-255.
  */
-void AW20216S::fillScreen(uint8_t r, uint8_t g, uint8_t b)
+void AW20216SBase::fillScreen(uint8_t r, uint8_t g, uint8_t b)
 {
-    for (uint16_t i = 0; i < AW_MAX_LEDS; i += 3)
+    for (uint16_t i = 0; i < _frameSize; i += 3)
     {
         _frameBuffer[i + 0] = r;
         _frameBuffer[i + 1] = g;
         _frameBuffer[i + 2] = b;
     }
+    _markDirty(0, (uint8_t)(_frameSize - 1u));
+}
+
+//******************************************************** */
+
+/**
+ * @brief Select the PROGMEM correction table applied to PWM bytes on output.
+ * 
+ * @param lut 768-byte table (R, G, B x 256), or nullptr to disable.
+ */
+void AW20216SBase::setOutputLut(const uint8_t *lut)
+{
+    waitShow();
+    _outputLut = lut;
+    invalidate(); // The chip holds values translated with the old table
 }
 
 //******************************************************** */
@@ -99,7 +254,7 @@ void AW20216S::fillScreen(uint8_t r, uint8_t g, uint8_t b)
  * 
  * @param current Master current, 0 (off) - 255 (max drive).
  */
-void AW20216S::setGlobalCurrent(uint8_t current)
+void AW20216SBase::setGlobalCurrent(uint8_t current)
 {
     // Configure the overall current for all LEDs [cite: 31]
     writeRegister(AW20216S_PAGE0, AW_REG_GCCR, current);
@@ -116,315 +271,2167 @@ void AW20216S::setGlobalCurrent(uint8_t current)
  * @param g Green PWM value, 0-255.
  * @param b Blue  PWM value, 0-255.
  */
-void AW20216S::setPixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b)
+void AW20216SBase::setPixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b)
 {
     if (x >= _cols || y >= _rows)
         return;
 
     // Physical layout: 18 channels per row, RGB packed
-    uint8_t *p = &_frameBuffer[AW_BASE_INDEX(x, y)];
-
-    *p++ = r;
-    *p++ = g;
-    *p = b;
+    _setPixelAt(AW_BASE_INDEX(x, y), r, g, b);
 }
 
 //******************************************************** */
 
 /**
- * @brief Burst-write the whole framebuffer (216 PWM bytes) to Page 1.
+ * @brief Fill a clipped rectangle with one color. Call show() to apply.
+ * 
+ * @param x Left column (may be negative).
+ * @param y Top row (may be negative).
+ * @param w Width in pixels.
+ * @param h Height in pixels.
+ * @param r Red   PWM value, 0-255.
+ * @param g Green PWM value, 0-255.
+ * @param b Blue  PWM value, 0-255.
  */
-void AW20216S::show()
+void AW20216SBase::fillRect(int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t r, uint8_t g, uint8_t b)
 {
-    _writePageBurst(AW20216S_PAGE1, _frameBuffer, AW_MAX_LEDS);
+    int16_t cw = w, ch = h;
+    uint8_t sx, sy;
+    if (!_clipRect(x, y, cw, ch, sx, sy))
+        return;
+
+    // Build the first row span, then copy it down: one memcpy per row.
+    const uint8_t first = AW_BASE_INDEX(x, y);
+    const uint8_t span = (uint8_t)(cw * 3);
+    uint8_t *p = &_frameBuffer[first];
+    for (uint8_t i = 0; i < span; i += 3)
+    {
+        p[i + 0] = r;
+        p[i + 1] = g;
+        p[i + 2] = b;
+    }
+    for (int16_t row = 1; row < ch; row++)
+        memcpy(&_frameBuffer[first + AW_BASE_Y(row)], p, span);
+
+    _markDirty(first, (uint8_t)(first + AW_BASE_Y(ch - 1) + span - 1u));
 }
 
-//******************************************************** */
+/**
+ * @brief Draw a clipped horizontal line. Call show() to apply.
+ * 
+ * @param x Left column (may be negative).
+ * @param y Row.
+ * @param w Length in pixels.
+ * @param r Red   PWM value, 0-255.
+ * @param g Green PWM value, 0-255.
+ * @param b Blue  PWM value, 0-255.
+ */
+void AW20216SBase::drawHLine(int16_t x, int16_t y, uint8_t w, uint8_t r, uint8_t g, uint8_t b)
+{
+    fillRect(x, y, w, 1, r, g, b);
+}
 
 /**
- * @brief Burst-write per-channel scaling (Page 2) to every pixel.
+ * @brief Draw a clipped vertical line. Call show() to apply.
  * 
- * @param r_scale Red   channel scale, 0 (off) - 255 (no attenuation).
- * @param g_scale Green channel scale, 0 (off) - 255 (no attenuation).
- * @param b_scale Blue  channel scale, 0 (off) - 255 (no attenuation).
+ * @param x Column.
+ * @param y Top row (may be negative).
+ * @param h Length in pixels.
+ * @param r Red   PWM value, 0-255.
+ * @param g Green PWM value, 0-255.
+ * @param b Blue  PWM value, 0-255.
  */
-void AW20216S::setScaling(uint8_t r_scale, uint8_t g_scale, uint8_t b_scale)
+void AW20216SBase::drawVLine(int16_t x, int16_t y, uint8_t h, uint8_t r, uint8_t g, uint8_t b)
 {
-    // Configure the mix current (Page 2) for all pixels.
-    // This is useful for overall white balance.
-    // We go through all the LEDs.
+    int16_t cw = 1, ch = h;
+    uint8_t sx, sy;
+    if (!_clipRect(x, y, cw, ch, sx, sy))
+        return;
 
-    // Burst write all 216 scaling bytes (Page 2)
-    _spiPort->beginTransaction(SPISettings(AW_SPI_SPEED, MSBFIRST, SPI_MODE0));
-    digitalWrite(_csPin, LOW);
+    const uint8_t first = AW_BASE_INDEX(x, y);
+    uint8_t *p = &_frameBuffer[first];
+    for (int16_t row = 0; row < ch; row++, p += AW_BASE_Y(1))
+    {
+        p[0] = r;
+        p[1] = g;
+        p[2] = b;
+    }
 
-    const uint8_t commandByte = AW_CMD_WRITE_PAGE(AW20216S_PAGE2);
+    _markDirty(first, (uint8_t)(first + AW_BASE_Y(ch - 1) + 2u));
+}
 
-    _spiPort->transfer(commandByte);
-    _spiPort->transfer(0x00); // Start address
+//******************************************************** */
 
-    // Fill Page2 scaling registers in the same linear order as PWM:
-    uint16_t i = 0;
-    while (i < AW_MAX_LEDS)
+/**
+ * @brief Shift the framebuffer in place and fill the uncovered edge.
+ * 
+ * @param dx Columns to shift right (negative: left).
+ * @param dy Rows to shift down (negative: up).
+ * @param r  Red   fill value, 0-255.
+ * @param g  Green fill value, 0-255.
+ * @param b  Blue  fill value, 0-255.
+ */
+void AW20216SBase::scroll(int8_t dx, int8_t dy, uint8_t r, uint8_t g, uint8_t b)
+{
+    const uint8_t ny = (uint8_t)(dy < 0 ? -dy : dy);
+    const uint8_t nx = (uint8_t)(dx < 0 ? -dx : dx);
+
+    if (ny >= _rows || nx >= _cols)
+    {
+        fillRect(0, 0, _cols, _rows, r, g, b);
+        return;
+    }
+
+    // Rows are contiguous 18-byte slices: a vertical shift is one memmove.
+    if (dy > 0)
     {
-        _spiPort->transfer(r_scale);
-        _spiPort->transfer(g_scale);
-        _spiPort->transfer(b_scale);
-        i += 3;
+        memmove(&_frameBuffer[AW_BASE_Y(ny)], _frameBuffer, AW_BASE_Y(_rows - ny));
+        fillRect(0, 0, _cols, ny, r, g, b);
+    }
+    else if (dy < 0)
+    {
+        memmove(_frameBuffer, &_frameBuffer[AW_BASE_Y(ny)], AW_BASE_Y(_rows - ny));
+        fillRect(0, (int16_t)(_rows - ny), _cols, ny, r, g, b);
+    }
+
+    if (dx != 0)
+    {
+        const uint8_t keep = (uint8_t)((_cols - nx) * 3u);
+        for (uint8_t y = 0; y < _rows; y++)
+        {
+            uint8_t *row = &_frameBuffer[AW_BASE_Y(y)];
+            if (dx > 0)
+                memmove(row + AW_BASE_X(nx), row, keep);
+            else
+                memmove(row, row + AW_BASE_X(nx), keep);
+        }
+        fillRect(dx > 0 ? 0 : (int16_t)(_cols - nx), 0, nx, _rows, r, g, b);
     }
 
-    digitalWrite(_csPin, HIGH);
-    _spiPort->endTransaction();
+    _markDirty(0, (uint8_t)(AW_BASE_Y(_rows) - 1u));
 }
 
 //******************************************************** */
 
+// SWAR kernels: four channel bytes per 32-bit word. Products run in two
+// 16-bit lanes (even bytes, odd bytes) so no lane carries into the next.
+#define AW_SWAR_LANES 0x00FF00FFUL
+
+// (a * (256 - w) + b * w + 128) >> 8 per byte, w = 0-256.
+struct AwSwarLerp
+{
+    uint32_t w;
+    inline uint32_t operator()(uint32_t a, uint32_t b) const
+    {
+        const uint32_t iw = 256u - w;
+        const uint32_t even = ((a & AW_SWAR_LANES) * iw + (b & AW_SWAR_LANES) * w + 0x00800080UL) >> 8;
+        const uint32_t odd = ((a >> 8) & AW_SWAR_LANES) * iw + ((b >> 8) & AW_SWAR_LANES) * w + 0x00800080UL;
+        return (even & AW_SWAR_LANES) | (odd & ~AW_SWAR_LANES);
+    }
+};
+
+// min(a + b, 255) per byte: add the low 7 bits, fix up bit 7, then turn
+// each byte's carry-out into 0xFF.
+struct AwSwarAddSat
+{
+    inline uint32_t operator()(uint32_t a, uint32_t b) const
+    {
+        const uint32_t sum = ((a & 0x7F7F7F7FUL) + (b & 0x7F7F7F7FUL)) ^ ((a ^ b) & 0x80808080UL);
+        const uint32_t carry = ((a & b) | ((a | b) & ~sum)) & 0x80808080UL;
+        return sum | ((carry >> 7) * 0xFFu);
+    }
+};
+
+// max(a, b) per byte: bit 8 of (a | 0x100) - b in each 16-bit lane is set
+// when a >= b.
+struct AwSwarMax
+{
+    inline uint32_t operator()(uint32_t a, uint32_t b) const
+    {
+        const uint32_t ae = a & AW_SWAR_LANES, be = b & AW_SWAR_LANES;
+        const uint32_t ao = (a >> 8) & AW_SWAR_LANES, bo = (b >> 8) & AW_SWAR_LANES;
+        const uint32_t me = ((((ae | 0x01000100UL) - be) >> 8) & 0x00010001UL) * 0xFFu;
+        const uint32_t mo = ((((ao | 0x01000100UL) - bo) >> 8) & 0x00010001UL) * 0xFFu;
+        return ((ae & me) | (be & ~me & AW_SWAR_LANES)) |
+               (((ao & mo) | (bo & ~mo & AW_SWAR_LANES)) << 8);
+    }
+};
+
 /**
- * @brief Write the raw PCCR register (PWM clock), masking reserved bits.
- * 
- * @param pccr Raw value: bits [7:5] frequency divider, bits [1:0] phase.
+ * @brief dst[i] = op(a[i], b[i]) over len bytes, one word at a time.
+ *
+ * Buffers need no alignment (memcpy compiles to plain loads where the
+ * target allows it); a short tail is padded into one last word.
  */
-void AW20216S::setPwmClock(uint8_t pccr)
+template <typename Op>
+static void awSwarBlend(uint8_t *dst, const uint8_t *a, const uint8_t *b, uint16_t len, Op op)
 {
-    // Keep reserved bits [4:2] at 0
-    pccr &= 0b11100011;
-    writeRegister(AW20216S_PAGE0, AW_REG_PCCR, pccr);
+    uint16_t i = 0;
+    for (; i + 4u <= len; i += 4u)
+    {
+        uint32_t wa, wb;
+        memcpy(&wa, a + i, 4);
+        memcpy(&wb, b + i, 4);
+        const uint32_t r = op(wa, wb);
+        memcpy(dst + i, &r, 4);
+    }
+    if (i < len)
+    {
+        uint32_t wa = 0, wb = 0;
+        memcpy(&wa, a + i, len - i);
+        memcpy(&wb, b + i, len - i);
+        const uint32_t r = op(wa, wb);
+        memcpy(dst + i, &r, len - i);
+    }
 }
 
 /**
- * @brief Build the PCCR value from a frequency/phase pair and write it.
+ * @brief Copy the active rows of the framebuffer out.
  * 
- * @param freq  PWM frequency (AwPwmFreq), High = 62.5 kHz .. Low = 488 Hz.
- * @param phase PWM phase scheme (AwPwmPhase), default PhaseDelay.
+ * @param out AW_FRAME_SIZE(rows) bytes.
  */
-void AW20216S::setPwmFrequency(AwPwmFreq freq, AwPwmPhase phase)
+void AW20216SBase::captureFrame(uint8_t *out) const
 {
-    // Pack PCCR: frequency divider in bits [7:5], phase in bits [1:0].
-    const uint8_t pccr =
-        (uint8_t)(((uint8_t)freq & 0x07) << 5) |
-        (uint8_t)((uint8_t)phase & 0x03);
-
-    setPwmClock(pccr);
+    memcpy(out, _frameBuffer, AW_BASE_Y(_rows));
 }
 
-//******************************************************** */
+/**
+ * @brief Interpolate two frames into the framebuffer.
+ * 
+ * @param from Frame at t = 0.
+ * @param to   Frame at t = 255.
+ * @param t    Position, 0-255.
+ */
+void AW20216SBase::crossfade(const uint8_t *from, const uint8_t *to, uint8_t t)
+{
+    AwSwarLerp op;
+    op.w = (uint32_t)t + (t >> 7); // 0-255 -> 0-256, so 255 lands on `to`
+    awSwarBlend(_frameBuffer, from, to, AW_BASE_Y(_rows), op);
+    _markDirty(0, (uint8_t)(AW_BASE_Y(_rows) - 1u));
+}
 
 /**
- * @brief Bind one channel of a pixel to a breathing pattern (Page 3).
+ * @brief Saturating add of a frame onto the framebuffer.
  * 
- * @param x   Column index, 0 - (cols-1). Out-of-range is ignored.
- * @param y   Row index,    0 - (rows-1). Out-of-range is ignored.
- * @param ch  Channel: AwChannel::R, ::G or ::B.
- * @param pat Pattern: PWM, PAT0, PAT1 or PAT2.
+ * @param src Frame to add.
  */
-void AW20216S::setChannelPattern(uint8_t x, uint8_t y, AwChannel ch, AwPattern pat)
+void AW20216SBase::blendAdd(const uint8_t *src)
 {
-    if (x >= _cols || y >= _rows)
-        return;
+    awSwarBlend(_frameBuffer, _frameBuffer, src, AW_BASE_Y(_rows), AwSwarAddSat());
+    _markDirty(0, (uint8_t)(AW_BASE_Y(_rows) - 1u));
+}
 
-    const uint8_t base = AW_BASE_INDEX(x, y);          // channel base (R)
-    const uint8_t led = (uint8_t)(base + (uint8_t)ch); // 0..215 (R/G/B channel)
+/**
+ * @brief Per-channel maximum of the framebuffer and a frame.
+ * 
+ * @param src Frame to combine.
+ */
+void AW20216SBase::blendMax(const uint8_t *src)
+{
+    awSwarBlend(_frameBuffer, _frameBuffer, src, AW_BASE_Y(_rows), AwSwarMax());
+    _markDirty(0, (uint8_t)(AW_BASE_Y(_rows) - 1u));
+}
 
-    // Page 3 packs 4 channels (2 bits each) per register: reg = led/3 group,
-    // shift = (led%3)*2 selects this channel's 2-bit field.
-    const uint8_t reg = (uint8_t)(AW_REG_PATG_BASE + (led / 3u));
-    const uint8_t shift = (uint8_t)((led % 3u) * 2u);
+//******************************************************** */
 
-    const uint8_t pat2 = ((uint8_t)pat) & 0x03u;
+/**
+ * @brief Enter (or leave, with nullptr) ring-buffer viewport mode.
+ * 
+ * @param ring     AW_VIEWPORT_SIZE(rows, ringCols) bytes, or nullptr.
+ * @param ringCols Ring width in pixels, at least cols.
+ * @return true if the viewport was set.
+ */
+bool AW20216SBase::setViewport(uint8_t *ring, uint16_t ringCols)
+{
+    if (ring != nullptr && ringCols < _cols)
+        return false;
+
+    waitShow();
+    _viewport = ring;
+    _viewCols = (ring != nullptr) ? ringCols : 0;
+    _viewX = 0;
+    invalidate(); // Leaving the mode resends the framebuffer in full
+    return true;
+}
 
-    // Read-modify-write so the other channels in this register are preserved.
-    uint8_t v = readRegister(AW20216S_PAGE3, reg);
-    v &= (uint8_t)~(0x03u << shift); // clear this channel's 2-bit field
-    v |= (uint8_t)(pat2 << shift);   // set the new pattern
-    writeRegister(AW20216S_PAGE3, reg, v);
+/**
+ * @brief Set the ring column shown at the left edge.
+ * 
+ * @param vx Ring column (wraps).
+ */
+void AW20216SBase::setViewportOrigin(uint16_t vx)
+{
+    if (_viewCols != 0)
+        _viewX = (uint16_t)(vx % _viewCols);
 }
 
 /**
- * @brief Bind the R, G and B channels of a pixel to breathing patterns.
+ * @brief Move the viewport origin.
  * 
- * @param x    Column index, 0 - (cols-1).
- * @param y    Row index,    0 - (rows-1).
- * @param rPat Pattern for Red:   PWM, PAT0, PAT1 or PAT2.
- * @param gPat Pattern for Green: PWM, PAT0, PAT1 or PAT2.
- * @param bPat Pattern for Blue:  PWM, PAT0, PAT1 or PAT2.
+ * @param dx Columns to move right (negative: left); wraps.
  */
-void AW20216S::setPixelPatternRGB(uint8_t x, uint8_t y, AwPattern rPat, AwPattern gPat, AwPattern bPat)
+void AW20216SBase::scrollViewport(int16_t dx)
 {
-    setChannelPattern(x, y, AwChannel::R, rPat);
-    setChannelPattern(x, y, AwChannel::G, gPat);
-    setChannelPattern(x, y, AwChannel::B, bPat);
+    if (_viewCols == 0)
+        return;
+
+    int32_t x = ((int32_t)_viewX + dx) % (int32_t)_viewCols;
+    if (x < 0)
+        x += _viewCols;
+    _viewX = (uint16_t)x;
 }
 
 /**
- * @brief Program the T0-T3 timings of a PATx engine and enable it.
+ * @brief Write one pixel of the viewport ring.
  * 
- * @param pat         Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
- * @param t0          Phase 0 rise time, 0-255.
- * @param t1          Phase 1 on (hold high) time, 0-255.
- * @param t2          Phase 2 fall time, 0-255.
- * @param t3          Phase 3 off (hold low) time, 0-255.
- * @param logarithmic true for logarithmic ramp, false for linear.
+ * @param vx Ring column (wraps).
+ * @param y  Row.
+ * @param r  Red   PWM value, 0-255.
+ * @param g  Green PWM value, 0-255.
+ * @param b  Blue  PWM value, 0-255.
  */
-void AW20216S::configureBreathing(AwPattern pat, uint8_t t0, uint8_t t1, uint8_t t2, uint8_t t3, bool logarithmic)
+void AW20216SBase::setViewportPixel(uint16_t vx, uint8_t y, uint8_t r, uint8_t g, uint8_t b)
 {
-    if (pat == AwPattern::PWM)
+    if (_viewport == nullptr || y >= _rows)
         return;
 
-    const uint8_t idx = AW_PAT_INDEX(pat);
-    const uint8_t tBase = AW_PAT_T_BASE(idx);
-    const uint8_t cfgAddr = AW_PAT_CFG_ADDR(idx);
+    uint8_t *p = &_viewport[((uint32_t)y * _viewCols + (vx % _viewCols)) * 3u];
+    p[0] = r;
+    p[1] = g;
+    p[2] = b;
+}
 
-    // T0–T3
-    writeRegister(AW20216S_PAGE0, tBase + 0, t0);
-    writeRegister(AW20216S_PAGE0, tBase + 1, t1);
-    writeRegister(AW20216S_PAGE0, tBase + 2, t2);
-    writeRegister(AW20216S_PAGE0, tBase + 3, t3);
+/**
+ * @brief Fill one column of the viewport ring.
+ * 
+ * @param vx Ring column (wraps).
+ * @param r  Red   PWM value, 0-255.
+ * @param g  Green PWM value, 0-255.
+ * @param b  Blue  PWM value, 0-255.
+ */
+void AW20216SBase::fillViewportColumn(uint16_t vx, uint8_t r, uint8_t g, uint8_t b)
+{
+    for (uint8_t y = 0; y < _rows; y++)
+        setViewportPixel(vx, y, r, g, b);
+}
 
-    // Read-modify-write PATxCFG
-    uint8_t cfg = readRegister(AW20216S_PAGE0, cfgAddr);
+//******************************************************** */
 
-    // Clear controllable bits
-    cfg &= ~(AW_PATCFG_PATEN |
-             AW_PATCFG_LOGEN |
-             AW_PATCFG_PATMD);
+/**
+ * @brief Enter (or leave, with nullptr) palette-indexed mode.
+ * 
+ * @param pixels  AW_INDEXED_SIZE(rows, bpp) bytes, or nullptr.
+ * @param bpp     Bits per pixel, 4 or 8.
+ * @param palette RGB triplets.
+ * @param entries Number of palette entries.
+ * @return true if the mode was changed.
+ */
+bool AW20216SBase::setIndexedFrame(uint8_t *pixels, uint8_t bpp, uint8_t *palette, uint16_t entries)
+{
+    if (pixels != nullptr && bpp != 4 && bpp != 8)
+        return false;
+    if (pixels == nullptr && _frameless())
+        return false; // No RGB framebuffer to return to
+
+    waitShow();
+    _indexed = pixels;
+    _palette = (pixels != nullptr) ? palette : nullptr;
+    _paletteSize = (pixels != nullptr && palette != nullptr) ? entries : 0;
+    if (pixels != nullptr)
+        _indexBpp = bpp;
+    invalidate(); // Leaving the mode resends the framebuffer in full
+    return true;
+}
 
-    // Enable breathing, autonomous mode
-    cfg |= AW_PATCFG_PATEN | AW_PATCFG_PATMD;
+/**
+ * @brief Write one indexed pixel.
+ * 
+ * @param x   Column.
+ * @param y   Row.
+ * @param idx Palette index.
+ */
+void AW20216SBase::setIndex(uint8_t x, uint8_t y, uint8_t idx)
+{
+    if (_indexed == nullptr || x >= _cols || y >= _rows)
+        return;
 
-    if (logarithmic)
+    if (_indexBpp == 8)
     {
-        cfg |= AW_PATCFG_LOGEN;
+        _indexed[AW_INDEXED_SIZE(y, 8) + x] = idx;
+        return;
     }
 
-    writeRegister(AW20216S_PAGE0, cfgAddr, cfg);
+    uint8_t *p = &_indexed[AW_INDEXED_SIZE(y, 4) + (x >> 1)];
+    if (x & 1u)
+        *p = (uint8_t)((*p & 0xF0u) | (idx & 0x0Fu));
+    else
+        *p = (uint8_t)((*p & 0x0Fu) | (uint8_t)(idx << 4));
 }
 
 /**
- * @brief Set the min/max brightness envelope of a PATx engine.
+ * @brief Read one indexed pixel.
  * 
- * @param pat  Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
- * @param minV Minimum brightness (bottom of breath), 0-255.
- * @param maxV Maximum brightness (top of breath), 0-255.
+ * @param x Column.
+ * @param y Row.
+ * @return Palette index, or 0 out of range / outside indexed mode.
  */
-void AW20216S::setBreathingBrightness(AwPattern pat, uint8_t minV, uint8_t maxV)
+uint8_t AW20216SBase::getIndex(uint8_t x, uint8_t y) const
 {
-    if (pat == AwPattern::PWM)
-        return;
-    const uint8_t idx = AW_PAT_INDEX(pat); // PAT0->0, PAT1->1, PAT2->2
+    if (_indexed == nullptr || x >= _cols || y >= _rows)
+        return 0;
+
+    if (_indexBpp == 8)
+        return _indexed[AW_INDEXED_SIZE(y, 8) + x];
 
-    writeRegister(AW20216S_PAGE0, (uint8_t)(AW_REG_PWMH0 + idx), maxV);
-    writeRegister(AW20216S_PAGE0, (uint8_t)(AW_REG_PWML0 + idx), minV);
+    const uint8_t v = _indexed[AW_INDEXED_SIZE(y, 4) + (x >> 1)];
+    return (x & 1u) ? (uint8_t)(v & 0x0Fu) : (uint8_t)(v >> 4);
 }
 
 /**
- * @brief Enable or disable a breathing engine by writing its PATxCFG.
+ * @brief Set the whole indexed frame to one index.
  * 
- * @param pat    Pattern engine: PAT0, PAT1 or PAT2.
- * @param enable true to enable, false to disable.
+ * @param idx Palette index.
  */
-void AW20216S::enableBreathing(AwPattern pat, bool enable)
+void AW20216SBase::fillIndex(uint8_t idx)
 {
-    uint8_t addr = AW_REG_PAT0CFG + (uint8_t)pat;
-    uint8_t cfg = enable ? 0x01 : 0x00;
+    if (_indexed == nullptr)
+        return;
 
-    writeRegister(AW20216S_PAGE0, addr, cfg);
+    if (_indexBpp == 4)
+        idx = (uint8_t)((idx & 0x0Fu) * 0x11u); // Both nibbles
+    memset(_indexed, idx, AW_INDEXED_SIZE(_rows, _indexBpp));
 }
 
 /**
- * @brief Trigger/restart a breathing engine via the PATGO register.
+ * @brief Write one palette entry.
  * 
- * @param pat Pattern engine to start: PAT0, PAT1 or PAT2 (PWM is ignored).
+ * @param i Entry.
+ * @param r Red   PWM value, 0-255.
+ * @param g Green PWM value, 0-255.
+ * @param b Blue  PWM value, 0-255.
  */
-void AW20216S::startBreathing(AwPattern pat)
+void AW20216SBase::setPaletteColor(uint8_t i, uint8_t r, uint8_t g, uint8_t b)
 {
-    if (pat == AwPattern::PWM)
+    if (i >= _paletteSize)
         return;
 
-    const uint8_t idx = AW_PAT_INDEX(pat);
-    writeRegister(AW20216S_PAGE0, AW_REG_PATGO, (uint8_t)(1u << idx));
+    uint8_t *p = &_palette[i * 3u];
+    p[0] = r;
+    p[1] = g;
+    p[2] = b;
 }
 
-//******************************************************** */
-
 /**
- * @brief Write one byte to a register using a 3-byte SPI write frame.
+ * @brief Rotate a range of palette entries by one.
  * 
- * @param page  Target page, 0-4.
- * @param reg   Register address within the page, 0x00-0xFF.
- * @param value Byte to write.
+ * @param first First entry.
+ * @param count Entries in the range.
+ * @param down  Rotate towards higher entries instead.
  */
-void AW20216S::writeRegister(uint8_t page, uint8_t reg, uint8_t value)
+void AW20216SBase::rotatePalette(uint8_t first, uint8_t count, bool down)
 {
-    // SPI Command Byte Structure [cite: 541, 543]
-    // Bit 7-4: ID (1010)
-    // Bit 3-1: Page ID (0-4)
-    // Bit 0:   W/R (0 = Write)
-
-    uint8_t commandByte = AW_CMD_WRITE_PAGE(page);
-
-    _spiPort->beginTransaction(SPISettings(AW_SPI_SPEED, MSBFIRST, SPI_MODE0));
+    if (first >= _paletteSize)
+        return;
+    if (count > _paletteSize - first)
+        count = (uint8_t)(_paletteSize - first);
+    if (count < 2)
+        return;
 
-    digitalWrite(_csPin, LOW);
-    _spiPort->transfer(commandByte); // 1. Send command (ID + Page + Write)
-    _spiPort->transfer(reg);         // 2. Send registration address
-    _spiPort->transfer(value);       // 3. Send data
-    digitalWrite(_csPin, HIGH);
+    uint8_t *p = &_palette[first * 3u];
+    const uint16_t span = (uint16_t)((count - 1u) * 3u);
+    uint8_t keep[3];
 
-    _spiPort->endTransaction();
+    if (down)
+    {
+        memcpy(keep, p + span, 3);
+        memmove(p + 3, p, span);
+        memcpy(p, keep, 3);
+    }
+    else
+    {
+        memcpy(keep, p, 3);
+        memmove(p, p + 3, span);
+        memcpy(p + span, keep, 3);
+    }
 }
 
 //******************************************************** */
 
 /**
- * @brief Read one byte from a register (sends a dummy byte to clock it out).
+ * @brief Copy a row-major RGB image from RAM. Call show() to apply.
  * 
- * @param page Target page, 0-4.
- * @param reg  Register address within the page, 0x00-0xFF.
- * @return The byte read back from the register.
+ * @param x   Left column (may be negative).
+ * @param y   Top row (may be negative).
+ * @param w   Image width in pixels.
+ * @param h   Image height in pixels.
+ * @param rgb w * h * 3 image bytes.
  */
-uint8_t AW20216S::readRegister(uint8_t page, uint8_t reg)
+void AW20216SBase::blitRGB(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *rgb)
 {
-    // Structure for Reading [cite: 555]
-
-    uint8_t commandByte = AW_CMD_READ_PAGE(page);
-    uint8_t result = 0;
-
-    _spiPort->beginTransaction(SPISettings(AW_SPI_SPEED, MSBFIRST, SPI_MODE0));
-
-    digitalWrite(_csPin, LOW);
-    _spiPort->transfer(commandByte);   // 1. Read Command
-    _spiPort->transfer(reg);           // 2. Direction
-    result = _spiPort->transfer(0x00); // 3. Read data (sends dummy 0x00)
-    digitalWrite(_csPin, HIGH);
+    _blitRGB(x, y, w, h, rgb, false);
+}
 
-    _spiPort->endTransaction();
+/**
+ * @brief Copy a row-major RGB image from flash. Call show() to apply.
+ * 
+ * @param x   Left column (may be negative).
+ * @param y   Top row (may be negative).
+ * @param w   Image width in pixels.
+ * @param h   Image height in pixels.
+ * @param rgb PROGMEM address of w * h * 3 image bytes.
+ */
+void AW20216SBase::blitRGB_P(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *rgb)
+{
+    _blitRGB(x, y, w, h, rgb, true);
+}
+
+/**
+ * @brief Draw a 1-bit bitmap from RAM in one color. Call show() to apply.
+ * 
+ * @param x    Left column (may be negative).
+ * @param y    Top row (may be negative).
+ * @param w    Bitmap width in pixels.
+ * @param h    Bitmap height in pixels.
+ * @param bits (w + 7) / 8 bytes per row, MSB = leftmost pixel.
+ * @param r    Red   PWM value of set bits, 0-255.
+ * @param g    Green PWM value of set bits, 0-255.
+ * @param b    Blue  PWM value of set bits, 0-255.
+ */
+void AW20216SBase::blit1bpp(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bits,
+                        uint8_t r, uint8_t g, uint8_t b)
+{
+    _blit1bpp(x, y, w, h, bits, r, g, b, false);
+}
+
+/**
+ * @brief Draw a 1-bit bitmap from flash in one color. Call show() to apply.
+ * 
+ * @param x    Left column (may be negative).
+ * @param y    Top row (may be negative).
+ * @param w    Bitmap width in pixels.
+ * @param h    Bitmap height in pixels.
+ * @param bits PROGMEM address, (w + 7) / 8 bytes per row, MSB = leftmost.
+ * @param r    Red   PWM value of set bits, 0-255.
+ * @param g    Green PWM value of set bits, 0-255.
+ * @param b    Blue  PWM value of set bits, 0-255.
+ */
+void AW20216SBase::blit1bpp_P(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bits,
+                          uint8_t r, uint8_t g, uint8_t b)
+{
+    _blit1bpp(x, y, w, h, bits, r, g, b, true);
+}
+
+/**
+ * @brief Clip a rectangle to the panel.
+ * 
+ * @param x    In: left column; out: first visible column.
+ * @param y    In: top row; out: first visible row.
+ * @param w    In: width; out: visible width.
+ * @param h    In: height; out: visible height.
+ * @param srcX Out: columns skipped on the left.
+ * @param srcY Out: rows skipped at the top.
+ * @return true if any part is visible.
+ */
+bool AW20216SBase::_clipRect(int16_t &x, int16_t &y, int16_t &w, int16_t &h,
+                         uint8_t &srcX, uint8_t &srcY) const
+{
+    srcX = 0;
+    srcY = 0;
+    if (x < 0)
+    {
+        if (-x >= w)
+            return false;
+        srcX = (uint8_t)(-x);
+        w += x;
+        x = 0;
+    }
+    if (y < 0)
+    {
+        if (-y >= h)
+            return false;
+        srcY = (uint8_t)(-y);
+        h += y;
+        y = 0;
+    }
+    if (x >= _cols || y >= _rows || w <= 0 || h <= 0)
+        return false;
+    if (x + w > _cols)
+        w = (int16_t)(_cols - x);
+    if (y + h > _rows)
+        h = (int16_t)(_rows - y);
+    return true;
+}
+
+/**
+ * @brief Row-wise RGB copy from RAM or PROGMEM.
+ * 
+ * @param x       Left column (may be negative).
+ * @param y       Top row (may be negative).
+ * @param w       Image width in pixels.
+ * @param h       Image height in pixels.
+ * @param rgb     Image bytes.
+ * @param progmem true if rgb points to flash.
+ */
+void AW20216SBase::_blitRGB(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *rgb, bool progmem)
+{
+    int16_t cw = w, ch = h;
+    uint8_t sx, sy;
+    if (rgb == nullptr || !_clipRect(x, y, cw, ch, sx, sy))
+        return;
+
+    const uint8_t first = AW_BASE_INDEX(x, y);
+    const uint8_t span = (uint8_t)(cw * 3);
+    const uint16_t stride = (uint16_t)w * 3u;
+    const uint8_t *src = rgb + (uint16_t)sy * stride + (uint16_t)sx * 3u;
+
+    for (int16_t row = 0; row < ch; row++, src += stride)
+    {
+        uint8_t *dst = &_frameBuffer[first + AW_BASE_Y(row)];
+        if (progmem)
+            memcpy_P(dst, src, span);
+        else
+            memcpy(dst, src, span);
+    }
+
+    _markDirty(first, (uint8_t)(first + AW_BASE_Y(ch - 1) + span - 1u));
+}
+
+/**
+ * @brief Draw the set bits of a 1-bit bitmap from RAM or PROGMEM.
+ * 
+ * @param x       Left column (may be negative).
+ * @param y       Top row (may be negative).
+ * @param w       Bitmap width in pixels.
+ * @param h       Bitmap height in pixels.
+ * @param bits    Bitmap bytes, (w + 7) / 8 per row, MSB first.
+ * @param r       Red   PWM value, 0-255.
+ * @param g       Green PWM value, 0-255.
+ * @param b       Blue  PWM value, 0-255.
+ * @param progmem true if bits points to flash.
+ */
+void AW20216SBase::_blit1bpp(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bits,
+                         uint8_t r, uint8_t g, uint8_t b, bool progmem)
+{
+    int16_t cw = w, ch = h;
+    uint8_t sx, sy;
+    if (bits == nullptr || !_clipRect(x, y, cw, ch, sx, sy))
+        return;
+
+    const uint8_t first = AW_BASE_INDEX(x, y);
+    const uint8_t stride = (uint8_t)((w + 7u) / 8u);
+
+    for (int16_t row = 0; row < ch; row++)
+    {
+        const uint8_t *src = bits + (uint16_t)(sy + row) * stride;
+        uint8_t *dst = &_frameBuffer[first + AW_BASE_Y(row)];
+
+        // The panel is at most 6 wide, so a visible row spans at most 2 bytes
+        // of the bitmap: fetch them once as a 16-bit window.
+        const uint8_t byteIdx = (uint8_t)(sx >> 3);
+        uint16_t window = (uint16_t)(progmem ? pgm_read_byte(src + byteIdx) : src[byteIdx]) << 8;
+        if ((uint8_t)(byteIdx + 1u) < stride)
+            window |= progmem ? pgm_read_byte(src + byteIdx + 1u) : src[byteIdx + 1u];
+        window = (uint16_t)(window << (sx & 7u));
+
+        for (int16_t col = 0; col < cw; col++, dst += 3, window <<= 1)
+        {
+            if (window & 0x8000u)
+            {
+                dst[0] = r;
+                dst[1] = g;
+                dst[2] = b;
+            }
+        }
+    }
+
+    _markDirty(first, (uint8_t)(first + AW_BASE_Y(ch - 1) + cw * 3 - 1u));
+}
+
+//******************************************************** */
+
+/**
+ * @brief Send the PWM bytes that changed since the last show() to Page 1.
+ */
+void AW20216SBase::show()
+{
+#if AW_ENABLE_STATS
+    const uint32_t t0 = micros();
+#endif
+    waitShow();
+
+    if (_flushFrame(false))
+        _endTransaction();
+
+#if AW_ENABLE_STATS
+    _stats.lastShowMicros = micros() - t0;
+    if (_stats.lastShowMicros > _stats.worstShowMicros)
+        _stats.worstShowMicros = _stats.lastShowMicros;
+#endif
+}
+
+/**
+ * @brief Send the changed framebuffer runs, opening the SPI transaction
+ *        only when something has to go out.
+ * 
+ * @param inTransaction true if the caller already holds this chip's bus.
+ * @return true if the transaction is (still) open on return.
+ */
+bool AW20216SBase::_flushFrame(bool inTransaction)
+{
+    if (_viewport != nullptr)
+    {
+        // The window moves as a whole: stream it, no delta.
+        if (!inTransaction)
+            _beginTransaction();
+        _writeViewportFrame();
+        _shadowValid = false; // Page 1 no longer matches the framebuffer
+        return true;
+    }
+
+    if (_indexed != nullptr)
+    {
+        // Palette edits touch every pixel: stream the whole frame.
+        if (!inTransaction)
+            _beginTransaction();
+        _writeIndexedFrame();
+        _shadowValid = false;
+        return true;
+    }
+
+    if (!_shadowValid)
+    {
+        // Chip content unknown: send the whole frame once.
+        if (!inTransaction)
+            _beginTransaction();
+        _writePwmFrame(AW_REG_PWM_BASE, _frameBuffer, _frameSize);
+        memcpy(_chipShadow, _frameBuffer, _frameSize);
+        _shadowValid = true;
+        _markClean();
+        return true;
+    }
+
+    if (_dirtyLo > _dirtyHi)
+        return inTransaction; // Nothing touched since the last show()
+
+    uint16_t i = _dirtyLo;
+    const uint16_t hi = _dirtyHi;
+
+    while (i <= hi)
+    {
+        if (_frameBuffer[i] == _chipShadow[i])
+        {
+            i++;
+            continue;
+        }
+
+        // Grow the run while the next change is close enough that resending
+        // the unchanged gap is cheaper than a new command header.
+        const uint16_t start = i;
+        uint16_t end = i; // Last changed byte of the run
+        for (i = start + 1; i <= hi && (uint16_t)(i - end) <= (AW_DELTA_MERGE_GAP + 1u); i++)
+        {
+            if (_frameBuffer[i] != _chipShadow[i])
+                end = i;
+        }
+
+        if (!inTransaction)
+        {
+            _beginTransaction();
+            inTransaction = true;
+        }
+
+        const uint16_t len = (uint16_t)(end - start + 1u);
+        _writePwmFrame((uint8_t)(AW_REG_PWM_BASE + start), &_frameBuffer[start], len);
+        memcpy(&_chipShadow[start], &_frameBuffer[start], len);
+    }
+
+    _markClean();
+    return inTransaction;
+}
+
+/**
+ * @brief Drop the chip shadow so the next show() sends the whole frame.
+ */
+void AW20216SBase::invalidate()
+{
+    _shadowValid = false;
+}
+
+//******************************************************** */
+
+/**
+ * @brief Hand the framebuffer to a DMA burst, or show() it where the core
+ *        cannot send in the background.
+ */
+void AW20216SBase::showAsync()
+{
+    waitShow();
+
+#if AW_HAS_SPI_ASYNC_TRANSFER
+    // Streamed (ring / palette), translated or transport frames have no
+    // buffer DMA can send as is.
+    if (_viewport == nullptr && _indexed == nullptr && _outputLut == nullptr &&
+        _transport == nullptr)
+    {
+        // The frame being sent becomes the chip shadow; the old shadow
+        // becomes the drawing buffer, so nothing is copied.
+        uint8_t *sent = _frameBuffer;
+        _frameBuffer = _chipShadow;
+        _chipShadow = sent;
+        _shadowValid = true;
+        _markDirty(0, (uint8_t)(_frameSize - 1u)); // Drawing buffer now holds an older frame
+
+        _beginTransaction();
+        _cs.low();
+        _spiPort->transfer(AW_CMD_WRITE_PAGE(AW20216S_PAGE1));
+        _spiPort->transfer(AW_REG_PWM_BASE);
+        _spiPort->transfer(sent, nullptr, _frameSize, false); // DMA, returns now
+        _noteFrame(AW20216S_PAGE1, (uint16_t)(_frameSize + 2u));
+        _asyncBusy = true; // CS and the transaction are released by _finishAsync()
+        return;
+    }
+#endif
+
+    // Nothing can run in the background: a blocking show(), and the
+    // framebuffer keeps the frame just sent, exactly as after show().
+    show();
+}
+
+/**
+ * @brief Report whether a showAsync() burst is still running.
+ * 
+ * @return true while the DMA transfer is in flight.
+ */
+bool AW20216SBase::isBusy()
+{
+#if AW_HAS_SPI_ASYNC_TRANSFER
+    if (_asyncBusy && !_spiPort->isBusy())
+        _finishAsync();
+#endif
+    return _asyncBusy;
+}
+
+/**
+ * @brief Wait for the pending showAsync() burst, if any, to complete.
+ */
+void AW20216SBase::waitShow()
+{
+    if (!_asyncBusy)
+        return;
+
+#if AW_HAS_SPI_ASYNC_TRANSFER
+    _spiPort->waitForTransfer();
+#endif
+    _finishAsync();
+}
+
+/**
+ * @brief Close the frame opened by showAsync() (CS high, end transaction).
+ */
+void AW20216SBase::_finishAsync()
+{
+    _cs.high();
+    _endTransaction();
+    _asyncBusy = false;
+}
+
+#if AW_ENABLE_STATS
+/**
+ * @brief Zero the driver counters.
+ */
+void AW20216SBase::resetStats()
+{
+    memset(&_stats, 0, sizeof(_stats));
+}
+#endif
+
+//******************************************************** */
+
+/**
+ * @brief Burst-write per-channel scaling (Page 2) to every pixel.
+ * 
+ * @param r_scale Red   channel scale, 0 (off) - 255 (no attenuation).
+ * @param g_scale Green channel scale, 0 (off) - 255 (no attenuation).
+ * @param b_scale Blue  channel scale, 0 (off) - 255 (no attenuation).
+ */
+void AW20216SBase::setScaling(uint8_t r_scale, uint8_t g_scale, uint8_t b_scale)
+{
+    // Configure the mix current (Page 2) for all pixels.
+    // This is useful for overall white balance.
+
+#if AW_ENABLE_SCALING_BUFFER
+    if (_scaling != nullptr)
+    {
+        // Fill Page2 scaling registers in the same linear order as PWM, then
+        // send the buffer in one burst.
+        for (uint16_t i = 0; i < _frameSize; i += 3)
+        {
+            _scaling[i + 0] = r_scale;
+            _scaling[i + 1] = g_scale;
+            _scaling[i + 2] = b_scale;
+        }
+        showScaling();
+        return;
+    }
+#endif
+
+    // No buffer: stream the triplet from a small stack chunk instead.
+    uint8_t chunk[48]; // 16 triplets
+
+    waitShow();
+    _beginTransaction();
+    _select();
+
+    _transfer(AW_CMD_WRITE_PAGE(AW20216S_PAGE2));
+    _transfer(AW_REG_SL_BASE); // Start address
+
+    uint16_t i = 0;
+    while (i < _frameSize)
+    {
+        uint16_t n = _frameSize - i;
+        if (n > sizeof(chunk))
+            n = sizeof(chunk);
+
+        // Refilled every pass: full-duplex transfers overwrite the chunk.
+        for (uint16_t k = 0; k < n; k += 3)
+        {
+            chunk[k + 0] = r_scale;
+            chunk[k + 1] = g_scale;
+            chunk[k + 2] = b_scale;
+        }
+        _transferBulk(chunk, n);
+        i += n;
+    }
+
+    _deselect();
+    _noteFrame(AW20216S_PAGE2, (uint16_t)(_frameSize + 2u));
+    _endTransaction();
+}
+
+#if AW_ENABLE_SCALING_BUFFER
+/**
+ * @brief Store one pixel's scaling in the scaling buffer (RAM only).
+ * 
+ * @param x       Column index, 0 - (cols-1). Out-of-range is ignored.
+ * @param y       Row index,    0 - (rows-1). Out-of-range is ignored.
+ * @param r_scale Red   channel scale, 0-255.
+ * @param g_scale Green channel scale, 0-255.
+ * @param b_scale Blue  channel scale, 0-255.
+ */
+void AW20216SBase::setPixelScaling(uint8_t x, uint8_t y, uint8_t r_scale, uint8_t g_scale, uint8_t b_scale)
+{
+    if (x >= _cols || y >= _rows || _scaling == nullptr)
+        return;
+
+    _setScalingAt(AW_BASE_INDEX(x, y), r_scale, g_scale, b_scale);
+}
+
+/**
+ * @brief Stream PWM + scaling of all LEDs interleaved to Page 4 in one burst.
+ */
+void AW20216SBase::showWithScaling()
+{
+    if (_scaling == nullptr)
+        return; // Indexed-only driver: nothing to interleave
+
+    waitShow();
+
+    _beginTransaction();
+    _select();
+
+    _transfer(AW_CMD_WRITE_PAGE(AW20216S_PAGE4));
+    _transfer(AW_REG_PWM_SL_BASE); // start address
+
+#if AW_HAS_SPI_BULK_TRANSFER
+    // Interleave through a small stack chunk so no 432-byte buffer is needed.
+    uint8_t chunk[AW_PAGE4_CHUNK_LEDS * 2u];
+    uint16_t i = 0;
+    while (i < _frameSize)
+    {
+        uint16_t n = _frameSize - i;
+        if (n > AW_PAGE4_CHUNK_LEDS)
+            n = AW_PAGE4_CHUNK_LEDS;
+
+        for (uint16_t k = 0; k < n; k++)
+        {
+            chunk[2u * k + 0u] = _outputPwm((uint8_t)(i + k), _frameBuffer[i + k]);
+            chunk[2u * k + 1u] = _scaling[i + k];
+        }
+        _transferBulk(chunk, (uint16_t)(2u * n));
+        i += n;
+    }
+#else
+    for (uint16_t i = 0; i < _frameSize; i++)
+    {
+        _transfer(_outputPwm((uint8_t)i, _frameBuffer[i]));
+        _transfer(_scaling[i]);
+    }
+#endif
+
+    _deselect();
+    _noteFrame(AW20216S_PAGE4, (uint16_t)(2u * _frameSize + 2u));
+    _endTransaction();
+
+    // Page 1 now matches the framebuffer.
+    memcpy(_chipShadow, _frameBuffer, _frameSize);
+    _shadowValid = true;
+    _markClean();
+}
+
+/**
+ * @brief Burst-write the whole scaling buffer (216 bytes) to Page 2.
+ */
+void AW20216SBase::showScaling()
+{
+    if (_scaling == nullptr)
+        return;
+
+    _writePageBurst(AW20216S_PAGE2, AW_REG_SL_BASE, _scaling, _frameSize);
+}
+
+//******************************************************** */
+
+// 16-bit pixels. A value v is brought to the PWM x SL range first,
+// t = v * 65025 / 65536 (at most 65023), then split by the 256-wide bucket
+// of t: SL is the smallest scale that keeps PWM <= 255 over the whole
+// bucket, and PWM = t / SL through a reciprocal, so no division per channel.
+namespace aw_split_detail
+{
+constexpr uint16_t bucketMax(uint16_t h)
+{
+    return ((h << 8) | 0xFFu) > 65023u ? 65023u : (uint16_t)((h << 8) | 0xFFu);
+}
+
+constexpr uint8_t scale(uint16_t h)
+{
+    return (uint8_t)((bucketMax(h) + 254u) / 255u);
+}
+
+constexpr uint16_t recip(uint16_t h)
+{
+    return (uint16_t)((65535u + scale(h) / 2u) / scale(h));
+}
+
+template <class S>
+struct Table;
+
+template <uint16_t... I>
+struct Table<aw_lut_detail::Seq<I...>>
+{
+    static const uint8_t scale[sizeof...(I)];
+    static const uint16_t recip[sizeof...(I)];
+};
+
+template <uint16_t... I>
+const uint8_t Table<aw_lut_detail::Seq<I...>>::scale[sizeof...(I)] PROGMEM = {
+    aw_split_detail::scale(I)...};
+
+template <uint16_t... I>
+const uint16_t Table<aw_lut_detail::Seq<I...>>::recip[sizeof...(I)] PROGMEM = {
+    aw_split_detail::recip(I)...};
+
+typedef Table<aw_lut_detail::MakeSeq<256>::type> Split;
+
+static_assert(scale(0) == 1 && scale(253) == 255, "split table: scale range");
+} // namespace aw_split_detail
+
+/**
+ * @brief Factor a 16-bit intensity into a PWM byte and a scaling byte.
+ * 
+ * @param v   Intensity, 0-65535.
+ * @param pwm Receives the PWM value.
+ * @param sl  Receives the scaling value.
+ */
+static inline void awSplit16(uint16_t v, uint8_t &pwm, uint8_t &sl)
+{
+    const uint16_t t = (uint16_t)(((uint32_t)v * 65025u) >> 16);
+    const uint8_t h = (uint8_t)(t >> 8);
+    const uint32_t p = ((uint32_t)t * pgm_read_word(&aw_split_detail::Split::recip[h]) + 0x8000u) >> 16;
+
+    sl = pgm_read_byte(&aw_split_detail::Split::scale[h]);
+    pwm = (p > 255u) ? 255u : (uint8_t)p;
+}
+
+/**
+ * @brief Store one 16-bit pixel as PWM + scaling (RAM only).
+ * 
+ * @param x Column index, 0 - (cols-1). Out-of-range is ignored.
+ * @param y Row index,    0 - (rows-1). Out-of-range is ignored.
+ * @param r Red   intensity, 0-65535.
+ * @param g Green intensity, 0-65535.
+ * @param b Blue  intensity, 0-65535.
+ */
+void AW20216SBase::setPixel16(uint8_t x, uint8_t y, uint16_t r, uint16_t g, uint16_t b)
+{
+    if (x >= _cols || y >= _rows || _scaling == nullptr)
+        return;
+
+    _setPixel16At(AW_BASE_INDEX(x, y), r, g, b);
+}
+
+/**
+ * @brief Fill every pixel with one 16-bit color (RAM only).
+ * 
+ * @param r Red   intensity, 0-65535.
+ * @param g Green intensity, 0-65535.
+ * @param b Blue  intensity, 0-65535.
+ */
+void AW20216SBase::fillScreen16(uint16_t r, uint16_t g, uint16_t b)
+{
+    if (_scaling == nullptr)
+        return;
+
+    uint8_t pwm[3], sl[3];
+    awSplit16(r, pwm[0], sl[0]);
+    awSplit16(g, pwm[1], sl[1]);
+    awSplit16(b, pwm[2], sl[2]);
+
+    for (uint16_t i = 0; i < _frameSize; i += 3)
+    {
+        _frameBuffer[i + 0] = pwm[0];
+        _frameBuffer[i + 1] = pwm[1];
+        _frameBuffer[i + 2] = pwm[2];
+        _setScalingAt((uint8_t)i, sl[0], sl[1], sl[2]);
+    }
+    _markDirty(0, (uint8_t)(_frameSize - 1u));
+}
+
+/**
+ * @brief Split a 16-bit triplet into the framebuffer and scaling buffer.
+ * 
+ * @param base Framebuffer index of the pixel's R byte.
+ * @param r    Red   intensity, 0-65535.
+ * @param g    Green intensity, 0-65535.
+ * @param b    Blue  intensity, 0-65535.
+ */
+void AW20216SBase::_setPixel16At(uint8_t base, uint16_t r, uint16_t g, uint16_t b)
+{
+    uint8_t pwm[3], sl[3];
+    awSplit16(r, pwm[0], sl[0]);
+    awSplit16(g, pwm[1], sl[1]);
+    awSplit16(b, pwm[2], sl[2]);
+
+    _setPixelAt(base, pwm[0], pwm[1], pwm[2]);
+    _setScalingAt(base, sl[0], sl[1], sl[2]);
+}
+
+//******************************************************** */
+
+// CRC-8, polynomial 0x07, initial value 0: guards stored calibration blobs.
+static uint8_t awCrc8(uint8_t crc, uint8_t data)
+{
+    crc ^= data;
+    for (uint8_t bit = 0; bit < 8; bit++)
+        crc = (crc & 0x80u) ? (uint8_t)((crc << 1) ^ 0x07u) : (uint8_t)(crc << 1);
+    return crc;
+}
+
+// Blob readers for the RAM / PROGMEM overloads of loadCalibration().
+static uint8_t awReadRam(uint16_t offset, void *ctx)
+{
+    return ((const uint8_t *)ctx)[offset];
+}
+
+static uint8_t awReadProgmem(uint16_t offset, void *ctx)
+{
+    return pgm_read_byte((const uint8_t *)ctx + offset);
+}
+
+// Blob writer for the RAM overload of saveCalibration().
+static void awWriteRam(uint16_t offset, uint8_t value, void *ctx)
+{
+    ((uint8_t *)ctx)[offset] = value;
+}
+
+/**
+ * @brief Size of this panel's calibration blob (header + payload + CRC).
+ * 
+ * @return Blob size in bytes.
+ */
+uint16_t AW20216SBase::calibrationSize() const
+{
+    return AW_CAL_BLOB_SIZE(_rows, _cols);
+}
+
+/**
+ * @brief Export the scaling buffer as a calibration blob into RAM.
+ * 
+ * @param out    Destination buffer.
+ * @param maxLen Capacity of out.
+ * @return Bytes written, or 0 if out is too small.
+ */
+uint16_t AW20216SBase::saveCalibration(uint8_t *out, uint16_t maxLen) const
+{
+    if (maxLen < calibrationSize() || _scaling == nullptr)
+        return 0;
+    return saveCalibration(awWriteRam, out);
+}
+
+/**
+ * @brief Export the scaling buffer as a calibration blob through a writer.
+ * 
+ * @param write Byte writer, called with increasing offsets.
+ * @param ctx   Opaque pointer passed to write.
+ * @return Bytes written.
+ */
+uint16_t AW20216SBase::saveCalibration(AwCalWriteFn write, void *ctx) const
+{
+    if (_scaling == nullptr)
+        return 0;
+
+    const uint8_t header[AW_CAL_HEADER_SIZE] = {AW_CAL_MAGIC, AW_CAL_VERSION, _rows, _cols};
+    uint16_t offset = 0;
+    uint8_t crc = 0;
+
+    for (uint8_t i = 0; i < AW_CAL_HEADER_SIZE; i++)
+    {
+        write(offset++, header[i], ctx);
+        crc = awCrc8(crc, header[i]);
+    }
+
+    // Only the populated part of each row is stored.
+    for (uint8_t y = 0; y < _rows; y++)
+    {
+        const uint8_t *row = &_scaling[AW_BASE_Y(y)];
+        for (uint8_t i = 0; i < (uint8_t)(_cols * 3u); i++)
+        {
+            write(offset++, row[i], ctx);
+            crc = awCrc8(crc, row[i]);
+        }
+    }
+
+    write(offset++, crc, ctx);
+    return offset;
+}
+
+/**
+ * @brief Load a calibration blob from RAM.
+ * 
+ * @param blob Blob bytes.
+ * @param len  Blob length.
+ * @return true if valid and loaded.
+ */
+bool AW20216SBase::loadCalibration(const uint8_t *blob, uint16_t len)
+{
+    return loadCalibration(awReadRam, len, (void *)blob);
+}
+
+/**
+ * @brief Load a calibration blob from flash (PROGMEM).
+ * 
+ * @param blob PROGMEM address of the blob.
+ * @param len  Blob length.
+ * @return true if valid and loaded.
+ */
+bool AW20216SBase::loadCalibration_P(const uint8_t *blob, uint16_t len)
+{
+    return loadCalibration(awReadProgmem, len, (void *)blob);
+}
+
+/**
+ * @brief Validate a calibration blob through a reader, then load it.
+ * 
+ * @param read Byte reader.
+ * @param len  Blob length available.
+ * @param ctx  Opaque pointer passed to read.
+ * @return true if valid and loaded; false leaves the buffer untouched.
+ */
+bool AW20216SBase::loadCalibration(AwCalReadFn read, uint16_t len, void *ctx)
+{
+    const uint16_t size = calibrationSize();
+    if (len < size || _scaling == nullptr)
+        return false;
+
+    if (read(0, ctx) != AW_CAL_MAGIC || read(1, ctx) != AW_CAL_VERSION ||
+        read(2, ctx) != _rows || read(3, ctx) != _cols)
+        return false;
+
+    // First pass: check the CRC without touching the buffer.
+    uint8_t crc = 0;
+    for (uint16_t i = 0; i < (uint16_t)(size - 1u); i++)
+        crc = awCrc8(crc, read(i, ctx));
+    if (crc != read((uint16_t)(size - 1u), ctx))
+        return false;
+
+    // Second pass: copy the payload row by row.
+    uint16_t offset = AW_CAL_HEADER_SIZE;
+    for (uint8_t y = 0; y < _rows; y++)
+    {
+        uint8_t *row = &_scaling[AW_BASE_Y(y)];
+        for (uint8_t i = 0; i < (uint8_t)(_cols * 3u); i++)
+            row[i] = read(offset++, ctx);
+    }
+    return true;
+}
+#endif
+
+//******************************************************** */
+
+/**
+ * @brief Write the raw PCCR register (PWM clock), masking reserved bits.
+ * 
+ * @param pccr Raw value: bits [7:5] frequency divider, bits [1:0] phase.
+ */
+void AW20216SBase::setPwmClock(uint8_t pccr)
+{
+    // Keep reserved bits [4:2] at 0
+    pccr &= 0b11100011;
+    writeRegister(AW20216S_PAGE0, AW_REG_PCCR, pccr);
+}
+
+/**
+ * @brief Build the PCCR value from a frequency/phase pair and write it.
+ * 
+ * @param freq  PWM frequency (AwPwmFreq), High = 62.5 kHz .. Low = 488 Hz.
+ * @param phase PWM phase scheme (AwPwmPhase), default PhaseDelay.
+ */
+void AW20216SBase::setPwmFrequency(AwPwmFreq freq, AwPwmPhase phase)
+{
+    // Pack PCCR: frequency divider in bits [7:5], phase in bits [1:0].
+    const uint8_t pccr =
+        (uint8_t)(((uint8_t)freq & 0x07) << 5) |
+        (uint8_t)((uint8_t)phase & 0x03);
+
+    setPwmClock(pccr);
+}
+
+//******************************************************** */
+
+/**
+ * @brief Bind one channel of a pixel to a breathing pattern (Page 3).
+ * 
+ * @param x   Column index, 0 - (cols-1). Out-of-range is ignored.
+ * @param y   Row index,    0 - (rows-1). Out-of-range is ignored.
+ * @param ch  Channel: AwChannel::R, ::G or ::B.
+ * @param pat Pattern: PWM, PAT0, PAT1 or PAT2.
+ */
+void AW20216SBase::setChannelPattern(uint8_t x, uint8_t y, AwChannel ch, AwPattern pat)
+{
+    if (x >= _cols || y >= _rows)
+        return;
+
+    _setChannelPatternAt((uint8_t)(AW_BASE_INDEX(x, y) + (uint8_t)ch), pat);
+}
+
+/**
+ * @brief Bind one channel, by framebuffer index, to a breathing pattern.
+ * 
+ * @param led Channel index 0..215 (R/G/B channel of a triplet).
+ * @param pat Pattern: PWM, PAT0, PAT1 or PAT2.
+ */
+void AW20216SBase::_setChannelPatternAt(uint8_t led, AwPattern pat)
+{
+    // Page 3 packs 3 channels (2 bits each, bits [5:0]) per register, so one
+    // register holds exactly one RGB triplet: reg = led/3, and
+    // shift = (led%3)*2 selects this channel's 2-bit field.
+    const uint8_t reg = (uint8_t)(AW_REG_PATG_BASE + (led / 3u));
+    const uint8_t shift = (uint8_t)((led % 3u) * 2u);
+
+    const uint8_t pat2 = ((uint8_t)pat) & 0x03u;
+
+    // Modify the RAM copy so the other channels in this register are
+    // preserved without reading the chip back.
+    uint8_t v = _patterns[reg];
+    v &= (uint8_t)~(0x03u << shift); // clear this channel's 2-bit field
+    v |= (uint8_t)(pat2 << shift);   // set the new pattern
+    writeRegister(AW20216S_PAGE3, reg, v);
+}
+
+/**
+ * @brief Bind the R, G and B channels of a pixel to breathing patterns.
+ * 
+ * @param x    Column index, 0 - (cols-1).
+ * @param y    Row index,    0 - (rows-1).
+ * @param rPat Pattern for Red:   PWM, PAT0, PAT1 or PAT2.
+ * @param gPat Pattern for Green: PWM, PAT0, PAT1 or PAT2.
+ * @param bPat Pattern for Blue:  PWM, PAT0, PAT1 or PAT2.
+ */
+void AW20216SBase::setPixelPatternRGB(uint8_t x, uint8_t y, AwPattern rPat, AwPattern gPat, AwPattern bPat)
+{
+    if (x >= _cols || y >= _rows)
+        return;
+
+    _setPixelPatternAt(AW_BASE_INDEX(x, y), rPat, gPat, bPat);
+}
+
+/**
+ * @brief Bind every pixel of a (clipped) rectangle to breathing patterns.
+ * 
+ * @param x    Left column.
+ * @param y    Top row.
+ * @param w    Width in columns.
+ * @param h    Height in rows.
+ * @param rPat Pattern for Red:   PWM, PAT0, PAT1 or PAT2.
+ * @param gPat Pattern for Green: PWM, PAT0, PAT1 or PAT2.
+ * @param bPat Pattern for Blue:  PWM, PAT0, PAT1 or PAT2.
+ */
+void AW20216SBase::setPatternRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+                              AwPattern rPat, AwPattern gPat, AwPattern bPat)
+{
+    if (x >= _cols || y >= _rows)
+        return;
+
+    const uint8_t x1 = (w > (uint8_t)(_cols - x)) ? _cols : (uint8_t)(x + w);
+    const uint8_t y1 = (h > (uint8_t)(_rows - y)) ? _rows : (uint8_t)(y + h);
+    const uint8_t v = _packPatterns(rPat, gPat, bPat);
+
+    for (uint8_t row = y; row < y1; row++)
+    {
+        for (uint8_t col = x; col < x1; col++)
+        {
+            _setPatternReg((uint8_t)(AW_BASE_INDEX(col, row) / 3u), v);
+        }
+    }
+}
+
+/**
+ * @brief Bind the pixels selected by a per-row bit mask to breathing patterns.
+ * 
+ * @param rowMasks One byte per row; bit x selects column x.
+ * @param rPat     Pattern for Red:   PWM, PAT0, PAT1 or PAT2.
+ * @param gPat     Pattern for Green: PWM, PAT0, PAT1 or PAT2.
+ * @param bPat     Pattern for Blue:  PWM, PAT0, PAT1 or PAT2.
+ */
+void AW20216SBase::setPatternMask(const uint8_t *rowMasks, AwPattern rPat, AwPattern gPat, AwPattern bPat)
+{
+    const uint8_t v = _packPatterns(rPat, gPat, bPat);
+
+    for (uint8_t row = 0; row < _rows; row++)
+    {
+        const uint8_t mask = rowMasks[row];
+        for (uint8_t col = 0; col < _cols; col++)
+        {
+            if (mask & (uint8_t)(1u << col))
+                _setPatternReg((uint8_t)(AW_BASE_INDEX(col, row) / 3u), v);
+        }
+    }
+}
+
+/**
+ * @brief Bind the selected channels of masked pixels to one pattern.
+ * 
+ * @param rowMasks One byte per row (bit x = column x), or nullptr for all.
+ * @param channels Channel bits (AW_CH_MASK()), others are kept.
+ * @param pat      Pattern for the selected channels.
+ */
+void AW20216SBase::setChannelPatternMask(const uint8_t *rowMasks, uint8_t channels, AwPattern pat)
+{
+    // Per-register field mask and value: 2 bits per selected channel.
+    uint8_t keep = 0xFF, set = 0;
+    for (uint8_t ch = 0; ch < 3; ch++)
+    {
+        if (channels & (uint8_t)(1u << ch))
+        {
+            keep &= (uint8_t)~(0x03u << (2u * ch));
+            set |= (uint8_t)(((uint8_t)pat & 0x03u) << (2u * ch));
+        }
+    }
+
+    for (uint8_t row = 0; row < _rows; row++)
+    {
+        const uint8_t mask = rowMasks ? rowMasks[row] : 0xFF;
+        for (uint8_t col = 0; col < _cols; col++)
+        {
+            if (mask & (uint8_t)(1u << col))
+            {
+                const uint8_t reg = (uint8_t)(AW_BASE_INDEX(col, row) / 3u);
+                _setPatternReg(reg, (uint8_t)((_patterns[reg] & keep) | set));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Bind every pixel of the panel to the same breathing patterns.
+ * 
+ * @param rPat Pattern for Red:   PWM, PAT0, PAT1 or PAT2.
+ * @param gPat Pattern for Green: PWM, PAT0, PAT1 or PAT2.
+ * @param bPat Pattern for Blue:  PWM, PAT0, PAT1 or PAT2.
+ */
+void AW20216SBase::setPatternAll(AwPattern rPat, AwPattern gPat, AwPattern bPat)
+{
+    setPatternRect(0, 0, _cols, _rows, rPat, gPat, bPat);
+}
+
+/**
+ * @brief Burst-write the changed range of the Page 3 copy to the chip.
+ */
+void AW20216SBase::commitPatterns()
+{
+    if (_patDirtyLo > _patDirtyHi)
+        return;
+
+    _writePageBurst(AW20216S_PAGE3, (uint8_t)(AW_REG_PATG_BASE + _patDirtyLo),
+                    &_patterns[_patDirtyLo], (uint16_t)(_patDirtyHi - _patDirtyLo + 1u));
+    _patDirtyLo = 0xFF;
+    _patDirtyHi = 0x00;
+}
+
+/**
+ * @brief Program the T0-T3 timings of a PATx engine and enable it.
+ * 
+ * @param pat         Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
+ * @param t0          Phase 0 rise time, 0-255.
+ * @param t1          Phase 1 on (hold high) time, 0-255.
+ * @param t2          Phase 2 fall time, 0-255.
+ * @param t3          Phase 3 off (hold low) time, 0-255.
+ * @param logarithmic true for logarithmic ramp, false for linear.
+ */
+void AW20216SBase::configureBreathing(AwPattern pat, uint8_t t0, uint8_t t1, uint8_t t2, uint8_t t3, bool logarithmic)
+{
+    if (pat == AwPattern::PWM)
+        return;
+
+    const uint8_t idx = AW_PAT_INDEX(pat);
+    const uint8_t tBase = AW_PAT_T_BASE(idx);
+    const uint8_t cfgAddr = AW_PAT_CFG_ADDR(idx);
+
+    // T0-T3 and PATxCFG go into the RAM copy first, then out as one burst.
+    _cachePage0((uint8_t)(tBase + 0), t0);
+    _cachePage0((uint8_t)(tBase + 1), t1);
+    _cachePage0((uint8_t)(tBase + 2), t2);
+    _cachePage0((uint8_t)(tBase + 3), t3);
+    _cachePage0(cfgAddr, _breathingCfg(_readPage0(cfgAddr), logarithmic));
+
+    // tBase..cfgAddr also spans the other engines' timers; they are resent
+    // unchanged from the copy, which is cheaper than a second CS frame.
+    _flushPage0(tBase, cfgAddr);
+}
+
+/**
+ * @brief Program timers, envelope and config of a PATx engine in one burst.
+ * 
+ * @param pat         Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
+ * @param t0          Phase 0 rise time, 0-255.
+ * @param t1          Phase 1 on (hold high) time, 0-255.
+ * @param t2          Phase 2 fall time, 0-255.
+ * @param t3          Phase 3 off (hold low) time, 0-255.
+ * @param minV        Minimum brightness (bottom of breath), 0-255.
+ * @param maxV        Maximum brightness (top of breath), 0-255.
+ * @param logarithmic true for logarithmic ramp, false for linear.
+ */
+void AW20216SBase::setupBreathing(AwPattern pat, uint8_t t0, uint8_t t1, uint8_t t2, uint8_t t3,
+                              uint8_t minV, uint8_t maxV, bool logarithmic)
+{
+    if (pat == AwPattern::PWM)
+        return;
+
+    const uint8_t idx = AW_PAT_INDEX(pat);
+    const uint8_t tBase = AW_PAT_T_BASE(idx);
+    const uint8_t cfgAddr = AW_PAT_CFG_ADDR(idx);
+
+    _cachePage0((uint8_t)(AW_REG_PWMH0 + idx), maxV);
+    _cachePage0((uint8_t)(AW_REG_PWML0 + idx), minV);
+    _cachePage0((uint8_t)(tBase + 0), t0);
+    _cachePage0((uint8_t)(tBase + 1), t1);
+    _cachePage0((uint8_t)(tBase + 2), t2);
+    _cachePage0((uint8_t)(tBase + 3), t3);
+    _cachePage0(cfgAddr, _breathingCfg(_readPage0(cfgAddr), logarithmic));
+
+    // PWMHx (0x30+idx) .. PATxCFG (0x42+idx): at most 19 registers, one frame
+    _flushPage0((uint8_t)(AW_REG_PWMH0 + idx), cfgAddr);
+}
+
+/**
+ * @brief Set the min/max brightness envelope of a PATx engine.
+ * 
+ * @param pat  Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
+ * @param minV Minimum brightness (bottom of breath), 0-255.
+ * @param maxV Maximum brightness (top of breath), 0-255.
+ */
+void AW20216SBase::setBreathingBrightness(AwPattern pat, uint8_t minV, uint8_t maxV)
+{
+    if (pat == AwPattern::PWM)
+        return;
+    const uint8_t idx = AW_PAT_INDEX(pat); // PAT0->0, PAT1->1, PAT2->2
+
+    _cachePage0((uint8_t)(AW_REG_PWMH0 + idx), maxV);
+    _cachePage0((uint8_t)(AW_REG_PWML0 + idx), minV);
+
+    // PWMHx and PWMLx are 3 apart: one 4-register burst beats two frames.
+    _flushPage0((uint8_t)(AW_REG_PWMH0 + idx), (uint8_t)(AW_REG_PWML0 + idx));
+}
+
+/**
+ * @brief Enable or disable a breathing engine by toggling PATEN in PATxCFG.
+ * 
+ * The other PATxCFG bits (mode, log ramp, ...) come from the RAM copy of
+ * Page 0 and are written back unchanged.
+ * 
+ * @param pat    Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
+ * @param enable true to enable, false to disable.
+ */
+void AW20216SBase::enableBreathing(AwPattern pat, bool enable)
+{
+    if (pat == AwPattern::PWM)
+        return;
+
+    const uint8_t cfgAddr = AW_PAT_CFG_ADDR(AW_PAT_INDEX(pat));
+    uint8_t cfg = _readPage0(cfgAddr);
+
+    if (enable)
+        cfg |= AW_PATCFG_PATEN;
+    else
+        cfg &= (uint8_t)~AW_PATCFG_PATEN;
+
+    writeRegister(AW20216S_PAGE0, cfgAddr, cfg);
+}
+
+/**
+ * @brief Trigger/restart a breathing engine via the PATGO register.
+ * 
+ * @param pat Pattern engine to start: PAT0, PAT1 or PAT2 (PWM is ignored).
+ */
+void AW20216SBase::startBreathing(AwPattern pat)
+{
+    if (pat == AwPattern::PWM)
+        return;
+
+    const uint8_t idx = AW_PAT_INDEX(pat);
+    writeRegister(AW20216S_PAGE0, AW_REG_PATGO, (uint8_t)(1u << idx));
+}
+
+//******************************************************** */
+
+/**
+ * @brief Write one byte to a register using a 3-byte SPI write frame.
+ * 
+ * @param page  Target page, 0-4.
+ * @param reg   Register address within the page, 0x00-0xFF.
+ * @param value Byte to write.
+ */
+void AW20216SBase::writeRegister(uint8_t page, uint8_t reg, uint8_t value)
+{
+    // SPI Command Byte Structure [cite: 541, 543]
+    // Bit 7-4: ID (1010)
+    // Bit 3-1: Page ID (0-4)
+    // Bit 0:   W/R (0 = Write)
+
+    uint8_t commandByte = AW_CMD_WRITE_PAGE(page);
+
+    waitShow();
+    _beginTransaction();
+
+    _select();
+    _transfer(commandByte); // 1. Send command (ID + Page + Write)
+    _transfer(reg);         // 2. Send registration address
+    _transfer(value);       // 3. Send data
+    _deselect();
+    _noteFrame(page, 3);
+
+    _endTransaction();
+
+    _noteWrite(page, reg, value);
+}
+
+/**
+ * @brief Burst-write consecutive registers of one page in one SPI frame.
+ * 
+ * @param page     Target page, 0-4.
+ * @param startReg First register address (auto-incremented by the chip).
+ * @param data     Bytes to write.
+ * @param len      Number of registers, clamped to AW_MAX_LEDS.
+ */
+void AW20216SBase::writeRegisters(uint8_t page, uint8_t startReg, const uint8_t *data, uint16_t len)
+{
+    if (data == nullptr || len == 0)
+        return;
+    if (len > AW_MAX_LEDS)
+        len = AW_MAX_LEDS;
+
+    _writePageBurst(page, startReg, data, len);
+
+    for (uint16_t i = 0; i < len; i++)
+        _noteWrite(page, (uint16_t)(startReg + i), data[i]);
+}
+
+/**
+ * @brief Keep the RAM copies coherent with a raw register write.
+ * 
+ * @param page  Page written, 0-4.
+ * @param reg   Register address (may run past 0xFF in a Page 4 burst).
+ * @param value Byte written.
+ */
+void AW20216SBase::_noteWrite(uint8_t page, uint16_t reg, uint8_t value)
+{
+    if (page == AW20216S_PAGE0 && reg < AW_PAGE0_REGS)
+        _cachePage0((uint8_t)reg, value);
+    else if (page == AW20216S_PAGE1 && reg < _frameSize)
+        _chipShadow[reg] = value;
+    else if (page == AW20216S_PAGE4 && (reg & 1u) == 0 && (reg >> 1) < _frameSize)
+        _chipShadow[reg >> 1] = value; // Even Page 4 addresses alias PWM
+    else if (page == AW20216S_PAGE3 && reg < _patternRegs())
+        _patterns[reg] = value;
+}
+
+//******************************************************** */
+
+/**
+ * @brief Read one byte from a register (sends a dummy byte to clock it out).
+ * 
+ * @param page Target page, 0-4.
+ * @param reg  Register address within the page, 0x00-0xFF.
+ * @return The byte read back from the register.
+ */
+uint8_t AW20216SBase::readRegister(uint8_t page, uint8_t reg)
+{
+    // Structure for Reading [cite: 555]
+
+    uint8_t commandByte = AW_CMD_READ_PAGE(page);
+    uint8_t result = 0;
+
+    waitShow();
+    _beginTransaction();
+
+    _select();
+    _transfer(commandByte);   // 1. Read Command
+    _transfer(reg);           // 2. Direction
+    result = _transfer(0x00); // 3. Read data (sends dummy 0x00)
+    _deselect();
+    _noteFrame(page, 2, 1);
+
+    _endTransaction();
 
     return result;
 }
 
+/**
+ * @brief Burst-read consecutive registers in one SPI frame.
+ * 
+ * @param page     Target page, 0-4.
+ * @param startReg First register address (auto-incremented by the chip).
+ * @param buf      Destination buffer.
+ * @param len      Number of bytes to read.
+ */
+void AW20216SBase::readRegisters(uint8_t page, uint8_t startReg, uint8_t *buf, uint16_t len)
+{
+    waitShow();
+    _beginTransaction();
+
+    _select();
+    _transfer(AW_CMD_READ_PAGE(page));
+    _transfer(startReg); // start address
+
+    if (_transport != nullptr)
+    {
+        _transport->read(buf, len);
+    }
+    else
+    {
+#if AW_HAS_SPI_BULK_TRANSFER
+        // Full-duplex in place: dummy zeros out, register data back in
+        memset(buf, 0, len);
+        _spiPort->transfer((void *)buf, (size_t)len);
+#else
+        for (uint16_t i = 0; i < len; i++)
+            buf[i] = _spiPort->transfer(0x00);
+#endif
+    }
+
+    _deselect();
+    _noteFrame(page, 2, len);
+
+    _endTransaction();
+}
+
+//******************************************************** */
+
+/**
+ * @brief Reload the Page 0 and Page 3 copies from the chip.
+ */
+void AW20216SBase::resyncFromChip()
+{
+    // One burst per page, straight into the RAM copies; the volatile Page 0
+    // slots are read too but never marked known.
+    readRegisters(AW20216S_PAGE0, 0x00, _page0, AW_PAGE0_REGS);
+    for (uint8_t reg = 0; reg < AW_PAGE0_REGS; reg++)
+        _cachePage0(reg, _page0[reg]);
+
+    readRegisters(AW20216S_PAGE3, AW_REG_PATG_BASE, _patterns, _patternRegs());
+    _patDirtyLo = 0xFF;
+    _patDirtyHi = 0x00;
+
+    invalidate(); // Page 1 is not read back: resend it on the next show()
+}
+
+//******************************************************** */
+
+/**
+ * @brief Blocking open + short scan of the populated channels.
+ * 
+ * @param map Receives the decoded fault bits.
+ * @return Number of faulty channels.
+ */
+uint16_t AW20216SBase::scanFaults(AwFaultMap &map)
+{
+    static const uint8_t modes[2] = {AW_GCR_OSDE_OPEN, AW_GCR_OSDE_SHORT};
+    uint8_t osr[AW_OSR_REGS];
+
+    _faultMap = nullptr; // Supersedes an incremental scan
+    memset(&map, 0, sizeof(map));
+
+    for (uint8_t pass = 0; pass < 2; pass++)
+    {
+        _setFaultDetect(modes[pass]);
+        delayMicroseconds(AW_FAULT_SETTLE_US);
+        readRegisters(AW20216S_PAGE0, AW_REG_OSR_BASE, osr, _faultRegs());
+        _decodeFaults(pass == 0 ? map.open : map.shorted, 0, osr, _faultRegs());
+    }
+
+    _setFaultDetect(0);
+    return map.count();
+}
+
+/**
+ * @brief Start an incremental open + short scan.
+ * 
+ * @param map Fault map filled by pollFaultScan().
+ */
+void AW20216SBase::beginFaultScan(AwFaultMap &map)
+{
+    memset(&map, 0, sizeof(map));
+    _faultMap = &map;
+    _faultReg = 0;
+    _setFaultDetect(AW_GCR_OSDE_OPEN);
+    _faultMode = AW_GCR_OSDE_OPEN;
+    _faultT0 = micros();
+}
+
+/**
+ * @brief Do the next step of the incremental scan, if it is due.
+ * 
+ * @return true when no scan is running any more.
+ */
+bool AW20216SBase::pollFaultScan()
+{
+    if (_faultMap == nullptr)
+        return true;
+
+    if (_faultReg >= _faultRegs())
+    {
+        // The last chunk of this pass was read by the previous poll; the GCR
+        // switch gets a poll of its own.
+        if (_faultMode == AW_GCR_OSDE_OPEN)
+        {
+            // Open pass done: the short pass starts on the next settle.
+            _setFaultDetect(AW_GCR_OSDE_SHORT);
+            _faultMode = AW_GCR_OSDE_SHORT;
+            _faultReg = 0;
+            _faultT0 = micros();
+            return false;
+        }
+
+        _setFaultDetect(0);
+        _faultMap = nullptr;
+        return true;
+    }
+
+    if (micros() - _faultT0 < AW_FAULT_SETTLE_US)
+        return false; // Detection not settled yet
+
+    uint8_t osr[AW_FAULT_SCAN_CHUNK];
+    uint8_t n = (uint8_t)(_faultRegs() - _faultReg);
+    if (n > AW_FAULT_SCAN_CHUNK)
+        n = AW_FAULT_SCAN_CHUNK;
+
+    readRegisters(AW20216S_PAGE0, (uint8_t)(AW_REG_OSR_BASE + _faultReg), osr, n);
+    _decodeFaults(_faultMode == AW_GCR_OSDE_OPEN ? _faultMap->open : _faultMap->shorted,
+                  _faultReg, osr, n);
+    _faultReg = (uint8_t)(_faultReg + n);
+    return false;
+}
+
+/**
+ * @brief Set the GCR open/short detection bits (other bits kept).
+ * 
+ * @param mode AW_GCR_OSDE_OPEN, AW_GCR_OSDE_SHORT or 0 (off).
+ */
+void AW20216SBase::_setFaultDetect(uint8_t mode)
+{
+    const uint8_t gcr = _readPage0(AW_REG_GCR);
+    const uint8_t next = (uint8_t)((gcr & (uint8_t)~AW_GCR_OSDE_MASK) | mode);
+    if (next != gcr)
+        writeRegister(AW20216S_PAGE0, AW_REG_GCR, next);
+}
+
+/**
+ * @brief Turn raw OSR bytes into per-channel bits.
+ * 
+ * OSR k holds SW line k / 3, CS lines 6 * (k % 3) .. +5 in bits [5:0], so
+ * bit b of OSR k is LED 6k + b, the same index as its PWM register.
+ * 
+ * @param bits  Open or short bitmap to set bits in.
+ * @param first Index of the first OSR register in osr.
+ * @param osr   Raw register values.
+ * @param n     Number of registers.
+ */
+void AW20216SBase::_decodeFaults(uint8_t *bits, uint8_t first, const uint8_t *osr, uint8_t n) const
+{
+    const uint8_t usedCs = AW_BASE_X(_cols); // CS lines wired on each SW line
+
+    for (uint8_t i = 0; i < n; i++)
+    {
+        const uint8_t k = (uint8_t)(first + i);
+        const uint8_t cs0 = (uint8_t)((k % 3u) * AW_OSR_BITS);
+        uint8_t v = (uint8_t)(osr[i] & ((1u << AW_OSR_BITS) - 1u));
+
+        for (uint8_t b = 0; v; b++, v >>= 1)
+        {
+            if ((v & 1u) && (uint8_t)(cs0 + b) < usedCs)
+            {
+                const uint8_t led = (uint8_t)(k * AW_OSR_BITS + b);
+                bits[led >> 3] |= (uint8_t)(1u << (led & 7u));
+            }
+        }
+    }
+}
+
+//******************************************************** */
+
+/**
+ * @brief Return a Page 0 register from RAM, reading it over SPI only once.
+ * 
+ * @param reg Page 0 register address.
+ * @return The register value.
+ */
+uint8_t AW20216SBase::_readPage0(uint8_t reg)
+{
+    if (reg < AW_PAGE0_REGS && !_isVolatilePage0(reg) &&
+        (_page0Known[reg >> 3] & (uint8_t)(1u << (reg & 7u))))
+        return _page0[reg];
+
+    const uint8_t value = readRegister(AW20216S_PAGE0, reg);
+    _cachePage0(reg, value);
+    return value;
+}
+
+/**
+ * @brief Store a Page 0 register value in the RAM copy (if cacheable).
+ * 
+ * @param reg   Page 0 register address.
+ * @param value Value now held by the chip.
+ */
+void AW20216SBase::_cachePage0(uint8_t reg, uint8_t value)
+{
+    if (reg >= AW_PAGE0_REGS || _isVolatilePage0(reg))
+        return;
+
+    _page0[reg] = value;
+    _page0Known[reg >> 3] |= (uint8_t)(1u << (reg & 7u));
+}
+
+/**
+ * @brief Drop the Page 0 copy and seed the registers with known defaults.
+ */
+void AW20216SBase::_seedPage0Defaults()
+{
+    memset(_page0Known, 0, sizeof(_page0Known));
+
+    // Datasheet power-on values of the registers the driver modifies; the
+    // rest is read once on first use.
+    _cachePage0(AW_REG_GCR, AW_GCR_DEFAULT);
+    _cachePage0(AW_REG_GCCR, 0x00);
+    _cachePage0(AW_REG_PCCR, 0x00);
+    for (uint8_t reg = AW_REG_PWMH0; reg <= (uint8_t)AW_PAT_CFG_ADDR(2); reg++)
+        _cachePage0(reg, 0x00); // PWMH/PWML, PATxT0-T3, PATxCFG
+}
+
+/**
+ * @brief Send Page 0 registers [lo, hi] from the RAM copy as one burst.
+ * 
+ * Registers in the range that were never cached are read once first, so
+ * the untouched neighbours are rewritten with their current value.
+ * 
+ * @param lo First register address.
+ * @param hi Last register address (inclusive, non-volatile range only).
+ */
+void AW20216SBase::_flushPage0(uint8_t lo, uint8_t hi)
+{
+    for (uint8_t reg = lo; reg <= hi; reg++)
+        _readPage0(reg);
+
+    _writePageBurst(AW20216S_PAGE0, lo, &_page0[lo], (uint16_t)(hi - lo + 1u));
+}
+
 //******************************************************** */
 
 /**
  * @brief Burst-write a block of bytes to a page in one SPI transaction.
  * 
- * @param page Target page, 0-4 (data starts at register address 0x00).
- * @param data Source buffer to transmit.
- * @param len  Number of bytes to transmit.
+ * @param page     Target page, 0-4.
+ * @param startReg First register address (auto-incremented by the chip).
+ * @param data     Source buffer to transmit.
+ * @param len      Number of bytes to transmit.
  */
-void AW20216S::_writePageBurst(uint8_t page, const uint8_t *data, uint16_t len)
+void AW20216SBase::_writePageBurst(uint8_t page, uint8_t startReg, const uint8_t *data, uint16_t len)
 {
-    const uint8_t commandByte = AW_CMD_WRITE_PAGE(page);
+    waitShow();
+    _beginTransaction();
+    _writeFrame(page, startReg, data, len);
+    _endTransaction();
+}
+
+/**
+ * @brief Send one CS-framed burst write inside an open SPI transaction.
+ * 
+ * @param page     Target page, 0-4.
+ * @param startReg First register address (auto-incremented by the chip).
+ * @param data     Source buffer to transmit.
+ * @param len      Number of bytes to transmit (at most AW_MAX_LEDS).
+ */
+void AW20216SBase::_writeFrame(uint8_t page, uint8_t startReg, const uint8_t *data, uint16_t len)
+{
+    _select();
 
-    _spiPort->beginTransaction(SPISettings(AW_SPI_SPEED, MSBFIRST, SPI_MODE0));
-    digitalWrite(_csPin, LOW);
+    _transfer(AW_CMD_WRITE_PAGE(page));
+    _transfer(startReg); // start address
+    _sendBytes(data, len);
 
-    _spiPort->transfer(commandByte);
-    _spiPort->transfer(0x00); // start address
+    _deselect();
+    _noteFrame(page, (uint16_t)(len + 2u));
+}
 
-#if AW_HAS_SPI_BULK_TRANSFER
-    // Protect original buffer (SPI is full-duplex)
-    memcpy(_spiScratch, data, len);
-    _spiPort->transfer((void *)_spiScratch, (size_t)len);
+/**
+ * @brief Send one CS-framed Page 1 burst through the output table.
+ * 
+ * @param startReg First PWM register address.
+ * @param data     Linear framebuffer bytes.
+ * @param len      Number of bytes to transmit (at most AW_MAX_LEDS).
+ */
+void AW20216SBase::_writePwmFrame(uint8_t startReg, const uint8_t *data, uint16_t len)
+{
+    _select();
+
+    _transfer(AW_CMD_WRITE_PAGE(AW20216S_PAGE1));
+    _transfer(startReg); // start address
+    _sendPwm(startReg, data, len);
+
+    _deselect();
+    _noteFrame(AW20216S_PAGE1, (uint16_t)(len + 2u));
+}
+
+/**
+ * @brief Stream the viewport window to Page 1 in one CS frame.
+ * 
+ * Each panel row is at most two ring segments (the window may wrap); the
+ * unused columns of narrow panels are sent as zeros so the burst stays one
+ * frame.
+ */
+void AW20216SBase::_writeViewportFrame()
+{
+    static const uint8_t pad[AW_BASE_Y(1)] = {0};
+    const uint16_t stride = (uint16_t)(_viewCols * 3u);
+    const uint8_t rowBytes = AW_BASE_X(_cols);
+    const uint8_t first = (_viewCols - _viewX < _cols) ? (uint8_t)(_viewCols - _viewX) : _cols;
+
+    _select();
+
+    _transfer(AW_CMD_WRITE_PAGE(AW20216S_PAGE1));
+    _transfer(AW_REG_PWM_BASE); // start address
+
+    for (uint8_t y = 0; y < _rows; y++)
+    {
+        const uint8_t *row = &_viewport[(uint32_t)y * stride];
+        const uint8_t reg = AW_BASE_Y(y);
+
+        _sendPwm(reg, row + (uint32_t)_viewX * 3u, AW_BASE_X(first));
+        if (first < _cols)
+            _sendPwm((uint8_t)(reg + AW_BASE_X(first)), row, (uint16_t)(rowBytes - AW_BASE_X(first)));
+        if (rowBytes < AW_BASE_Y(1) && (uint8_t)(y + 1u) < _rows)
+            _sendBytes(pad, (uint16_t)(AW_BASE_Y(1) - rowBytes));
+    }
+
+    _deselect();
+    _noteFrame(AW20216S_PAGE1, (uint16_t)(AW_BASE_Y(_rows - 1u) + rowBytes + 2u));
+}
+
+/**
+ * @brief Stream the indexed frame to Page 1 in one CS frame.
+ * 
+ * Each row is expanded into an 18-byte stack buffer and sent through the
+ * output table; unused columns of narrow panels go out as zeros so the
+ * burst stays one frame.
+ */
+void AW20216SBase::_writeIndexedFrame()
+{
+    uint8_t row[AW_BASE_Y(1)];
+    const uint8_t rowBytes = AW_BASE_X(_cols);
+    const uint8_t stride = (uint8_t)AW_INDEXED_SIZE(1, _indexBpp);
+
+    memset(row, 0, sizeof(row));
+
+    _select();
+
+    _transfer(AW_CMD_WRITE_PAGE(AW20216S_PAGE1));
+    _transfer(AW_REG_PWM_BASE); // start address
+
+    for (uint8_t y = 0; y < _rows; y++)
+    {
+        const uint8_t *src = &_indexed[(uint16_t)y * stride];
+
+        for (uint8_t x = 0; x < _cols; x++)
+        {
+            uint8_t idx;
+            if (_indexBpp == 8)
+                idx = src[x];
+            else
+                idx = (x & 1u) ? (uint8_t)(src[x >> 1] & 0x0Fu) : (uint8_t)(src[x >> 1] >> 4);
+
+            uint8_t *dst = &row[AW_BASE_X(x)];
+            if (idx < _paletteSize)
+            {
+                const uint8_t *c = &_palette[idx * 3u];
+                dst[0] = c[0];
+                dst[1] = c[1];
+                dst[2] = c[2];
+            }
+            else
+            {
+                dst[0] = dst[1] = dst[2] = 0;
+            }
+        }
+
+        // Pad narrow rows up to the next row's first register.
+        const uint8_t n = ((uint8_t)(y + 1u) < _rows) ? (uint8_t)AW_BASE_Y(1) : rowBytes;
+        _sendPwm(AW_BASE_Y(y), row, n);
+    }
+
+    _deselect();
+    _noteFrame(AW20216S_PAGE1, (uint16_t)(AW_BASE_Y(_rows - 1u) + rowBytes + 2u));
+}
+
+/**
+ * @brief Clock out data bytes inside an open CS frame, leaving the source
+ *        untouched.
+ * 
+ * @param data Source buffer to transmit.
+ * @param len  Number of bytes to transmit.
+ */
+void AW20216SBase::_sendBytes(const uint8_t *data, uint16_t len)
+{
+    if (_transport != nullptr)
+    {
+        _transport->write(data, len);
+        return;
+    }
+
+#if AW_HAS_SPI_WRITE_BYTES
+    // TX-only bulk write: the source buffer is left untouched
+    _spiPort->writeBytes(data, (uint32_t)len);
+#elif AW_HAS_SPI_ASYNC_TRANSFER
+    // Blocking use of the DMA transfer, without an RX buffer
+    _spiPort->transfer(data, nullptr, (size_t)len, true);
+#elif AW_NEEDS_SPI_SCRATCH
+    // Protect original buffer (SPI is full-duplex). The scratch holds one
+    // frame, so longer register bursts go out in frame-sized pieces.
+    while (len)
+    {
+        const uint16_t n = (len > _frameSize) ? _frameSize : len;
+        memcpy(_spiScratch, data, n);
+        _transferBulk(_spiScratch, n);
+        data += n;
+        len -= n;
+    }
 #else
     // no bulk transfer so byte-wise transfer
     const uint8_t *p = data;
@@ -433,7 +2440,89 @@ void AW20216S::_writePageBurst(uint8_t page, const uint8_t *data, uint16_t len)
         _spiPort->transfer(*p++);
     }
 #endif
+}
+
+/**
+ * @brief Clock out PWM bytes inside an open CS frame, through the output
+ *        table if one is set.
+ * 
+ * @param reg  PWM register of the first byte (selects the table row).
+ * @param data Linear framebuffer bytes.
+ * @param len  Number of bytes to transmit (at most AW_MAX_LEDS).
+ */
+void AW20216SBase::_sendPwm(uint8_t reg, const uint8_t *data, uint16_t len)
+{
+    if (_outputLut == nullptr)
+    {
+        _sendBytes(data, len);
+        return;
+    }
+
+    // Table row of the first byte; PWM registers cycle R, G, B.
+    uint16_t row = (uint16_t)(reg % 3u) << 8;
+
+#if AW_NEEDS_SPI_SCRATCH
+    // Translate during the copy the full-duplex transfer needs anyway
+    while (len)
+    {
+        const uint16_t n = (len > _frameSize) ? _frameSize : len;
+        for (uint16_t i = 0; i < n; i++)
+        {
+            _spiScratch[i] = pgm_read_byte(&_outputLut[row | *data++]);
+            row = (row == 0x200u) ? 0u : (uint16_t)(row + 0x100u);
+        }
+        _transferBulk(_spiScratch, n);
+        len -= n;
+    }
+#elif AW_HAS_SPI_WRITE_BYTES || AW_HAS_SPI_ASYNC_TRANSFER
+    // TX-only cores stream straight from RAM: translate through a small
+    // stack chunk (same budget as showWithScaling())
+    uint8_t chunk[AW_PAGE4_CHUNK_LEDS * 2u];
+    while (len)
+    {
+        const uint16_t n = (len > sizeof(chunk)) ? (uint16_t)sizeof(chunk) : len;
+        for (uint16_t k = 0; k < n; k++)
+        {
+            chunk[k] = pgm_read_byte(&_outputLut[row | *data++]);
+            row = (row == 0x200u) ? 0u : (uint16_t)(row + 0x100u);
+        }
+        _transferBulk(chunk, n);
+        len -= n;
+    }
+#else
+    // Byte-wise cores: one table read per byte in the transfer loop
+    while (len--)
+    {
+        _transfer(pgm_read_byte(&_outputLut[row | *data++]));
+        row = (row == 0x200u) ? 0u : (uint16_t)(row + 0x100u);
+    }
+#endif
+}
+
+/**
+ * @brief Clock out a scratch buffer inside an open CS frame.
+ * 
+ * @param buf Bytes to send; may be overwritten with MISO data.
+ * @param len Number of bytes to send.
+ */
+void AW20216SBase::_transferBulk(uint8_t *buf, uint16_t len)
+{
+    if (_transport != nullptr)
+    {
+        _transport->write(buf, len);
+        return;
+    }
 
-    digitalWrite(_csPin, HIGH);
-    _spiPort->endTransaction();
-}
\ No newline at end of file
+#if AW_HAS_SPI_WRITE_BYTES
+    _spiPort->writeBytes(buf, (uint32_t)len);
+#elif AW_HAS_SPI_ASYNC_TRANSFER
+    _spiPort->transfer(buf, nullptr, (size_t)len, true);
+#elif AW_HAS_SPI_BULK_TRANSFER
+    _spiPort->transfer((void *)buf, (size_t)len);
+#else
+    while (len--)
+    {
+        _spiPort->transfer(*buf++);
+    }
+#endif
+}
@@ -5,6 +5,9 @@
 #include <SPI.h>
 #include <string.h>
 
+#include "AW20216SColorLut.h"
+#include "AW20216STransport.h"
+
 /**
  * Registers definitions del AW20216S
  * Datasheet Page 22 - Register List
@@ -24,6 +27,15 @@
 #define AW_REG_RSTN             0x2F // Soft Reset (Write 0xAE)
 #define AW_REG_MIXCR            0x46 // Mix Function (Enable Page 4)
 #define AW_REG_SDCR             0x4D // SW Drive Capability
+#define AW_PAGE0_REGS           0x4E // GCR .. SDCR, mirrored in RAM
+#define AW_GCR_DEFAULT          0xB0 // Power-on GCR: SWSEL=1011 (12 rows), chip disabled
+#define AW_GCR_SWSEL_MASK       0xF0 // GCR bits [7:4]: active SW lines - 1
+#define AW_GCR_SWSEL(rows)      (uint8_t)((((uint8_t)(rows) - 1u) & 0x0Fu) << 4)
+#define AW_GCR_OSDE_MASK        0x06 // GCR bits [2:1]: open/short detect enable
+#define AW_GCR_OSDE_SHORT       0x02 // 01: short detection
+#define AW_GCR_OSDE_OPEN        0x06 // 11: open detection
+#define AW_OSR_REGS             36   // OSR0-OSR35: 3 per SW line
+#define AW_OSR_BITS             6    // LEDs per OSR register (bits [5:0])
 
 // Automatic Breathing Registers  (Breath Pattern) - Page 0
 #define AW_REG_PWMH0            0x30 // PWMH0-PWMH2 Maximum Brightness for Auto Breath (until 0x32)
@@ -43,20 +55,26 @@
 #define AW_REG_SL_BASE          0x00
 
 // --- PAGE 3: Pattern Choice ---
-// Assign each LED to a pattern driver.
+// Assign each LED to a pattern driver. 72 registers (0x00 to 0x47), one per
+// RGB triplet: bits [1:0] = channel 0 (R), [3:2] = G, [5:4] = B.
 #define AW20216S_PAGE3          0x03
 #define AW_REG_PATG_BASE        0x00
+#define AW_PATG_REGS            72
 
 // --- PAGE 4: Virtual Page (PWM + Scaling) ---
-// It allows writing PWM and SL in a single transaction.
+// It allows writing PWM and SL in a single transaction. Each LED takes two
+// consecutive addresses (PWM then SL), 432 bytes from 0x000 to 0x1AF, reached
+// by auto-increment from a 0x00 start address.
 #define AW20216S_PAGE4          0x04
 #define AW_REG_PWM_SL_BASE      0x00
 
 // --- Constants ---
 #define AW_CHIPID_SPI           0xA0 // Fixed part of the first SPI byte (1010xxxx) [cite: 542]
 #define AW_RST_CMD              0xAE // Command to reset the chip [cite: 716]
+#define AW_RESET_DELAY          2    // ms of OTP loading after a reset [cite: 524]
 #define AW_GLOBAL_ENABLE        0x01 // Bit CHIPEN in GCR [cite: 700]
 #define AW_MAX_LEDS             216
+#define AW_MAX_ROWS             12   // SW1-SW12
 
 // --- General Enumerations ---
 
@@ -68,6 +86,15 @@ enum class AwChannel : uint8_t {
     B = 2  // Blue  channel (offset 2)
 };
 
+// Clockwise rotation of a panel as mounted, used when mapping world
+// coordinates onto a chip (see AW20216SArray).
+enum class AwRotation : uint8_t {
+    R0   = 0, // Panel upright: world x -> column, world y -> row
+    R90  = 1, // Turned 90 deg clockwise
+    R180 = 2, // Upside down
+    R270 = 3  // Turned 90 deg counter-clockwise
+};
+
 // --- PAGE 0: Enumerations ---
 
 // PWM Frequency Options (PCCR Register) [page: 27]
@@ -110,11 +137,39 @@ enum class AwPattern : uint8_t {
 //******************************************************** */
 
 // Supported cores with SPI bulk transfer
+#ifndef AW_HAS_SPI_BULK_TRANSFER
 #if defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_ESP32)
 #define AW_HAS_SPI_BULK_TRANSFER 1
 #else
 #define AW_HAS_SPI_BULK_TRANSFER 0
 #endif
+#endif
+
+// ESP32: SPIClass::writeBytes() is TX-only, so bursts stream straight from
+// the framebuffer without a scratch copy.
+#ifndef AW_HAS_SPI_WRITE_BYTES
+#if defined(ARDUINO_ARCH_ESP32)
+#define AW_HAS_SPI_WRITE_BYTES 1
+#else
+#define AW_HAS_SPI_WRITE_BYTES 0
+#endif
+#endif
+
+// Cores whose SPIClass offers a non-blocking DMA transfer(txbuf, rxbuf,
+// count, block) plus isBusy()/waitForTransfer() (e.g. the Adafruit SAMD
+// core). Opt in with -DAW_HAS_SPI_ASYNC_TRANSFER=1; showAsync() then returns
+// while the frame is still on the wire.
+#ifndef AW_HAS_SPI_ASYNC_TRANSFER
+#define AW_HAS_SPI_ASYNC_TRANSFER 0
+#endif
+
+// Full-duplex bulk transfer(buf, len) overwrites its buffer with MISO data:
+// only those cores need a scratch copy of each burst.
+#if AW_HAS_SPI_BULK_TRANSFER && !AW_HAS_SPI_WRITE_BYTES && !AW_HAS_SPI_ASYNC_TRANSFER
+#define AW_NEEDS_SPI_SCRATCH 1
+#else
+#define AW_NEEDS_SPI_SCRATCH 0
+#endif
 
 // AVR (Uno/Leonardo): max SPI clock is typically F_CPU/2 => 8 MHz @ 16 MHz
 #if defined(ARDUINO_ARCH_AVR)
@@ -123,10 +178,149 @@ enum class AwPattern : uint8_t {
 #define AW_SPI_SPEED 10000000UL // 10MHz Max SPI Speed [cite: 455]
 #endif
 
+// Per-LED scaling buffer (18 bytes of RAM per row) behind setPixelScaling(),
+// showWithScaling(), setPixel16() and the calibration blobs. Off by default on
+// AVR (2 KB of SRAM on an Uno): build with -DAW_ENABLE_SCALING_BUFFER=1 to opt
+// in. The uniform setScaling() is always available.
+#ifndef AW_ENABLE_SCALING_BUFFER
+#if defined(ARDUINO_ARCH_AVR)
+#define AW_ENABLE_SCALING_BUFFER 0
+#else
+#define AW_ENABLE_SCALING_BUFFER 1
+#endif
+#endif
+
+// showWithScaling() interleaves PWM/SL through a stack chunk of this many
+// LEDs (2 bytes each) on bulk-transfer cores.
+#ifndef AW_PAGE4_CHUNK_LEDS
+#define AW_PAGE4_CHUNK_LEDS 24
+#endif
+
+// Calibration blob (per-LED scaling), see saveCalibration()/loadCalibration():
+//   [0] AW_CAL_MAGIC  [1] AW_CAL_VERSION  [2] rows  [3] cols
+//   [4 .. 4+rows*cols*3)  scaling bytes, row-major, R/G/B per pixel
+//   [last]                CRC-8 (poly 0x07) over everything before it
+#define AW_CAL_MAGIC        0xA7
+#define AW_CAL_VERSION      1
+#define AW_CAL_HEADER_SIZE  4
+#define AW_CAL_BLOB_SIZE(rows, cols) (uint16_t)(AW_CAL_HEADER_SIZE + (uint16_t)(rows) * (cols) * 3u + 1u)
+
+// Driver statistics (getStats()/resetStats()): SPI transactions, CS frames,
+// bytes per page and time spent holding the bus. Off by default; when 0 the
+// counters, their RAM and the micros() reads are compiled out.
+#ifndef AW_ENABLE_STATS
+#define AW_ENABLE_STATS 0
+#endif
+
+#define AW_STATS_PAGES 5 // Pages 0-4, indexes of bytesWritten[]/bytesRead[]
+
+// Viewport ring buffer (see setViewport()): rows x ringCols RGB pixels,
+// row-major.
+#define AW_VIEWPORT_SIZE(rows, ringCols) ((uint16_t)(rows) * (ringCols) * 3u)
+
+// Scene frame for captureFrame() / crossfade() / blendAdd() / blendMax():
+// the framebuffer layout, 18 bytes per row.
+#define AW_FRAME_SIZE(rows) ((uint16_t)(rows) * 18u)
+
+// Indexed framebuffer (see setIndexedFrame()): 6 pixels per row at bpp
+// bits each (4 or 8), row-major; with 4 bpp the left pixel of a byte is
+// the high nibble.
+#define AW_INDEXED_SIZE(rows, bpp) ((uint16_t)(rows) * 6u * (bpp) / 8u)
+
+#if AW_ENABLE_STATS
+// Driver counters since construction / resetStats(). Times in microseconds.
+struct AwDriverStats
+{
+    uint32_t transactions;                  // SPI beginTransaction() calls
+    uint32_t csToggles;                     // CS edges (2 per command frame)
+    uint32_t bytesWritten[AW_STATS_PAGES];  // MOSI bytes per page, headers included
+    uint32_t bytesRead[AW_STATS_PAGES];     // MISO data bytes per page
+    uint32_t spiMicros;                     // Time spent inside SPI transactions
+    uint32_t lastShowMicros;                // Duration of the last show()
+    uint32_t worstShowMicros;               // Longest show() so far
+};
+#endif
+
+// Open/short scan (see scanFaults()): time detection needs after GCR enables
+// it before the OSR bits are valid (at least one full row-scan cycle; raise it
+// for PWM clocks below 3.9 kHz), and OSR registers read per pollFaultScan().
+#ifndef AW_FAULT_SETTLE_US
+#define AW_FAULT_SETTLE_US 5000
+#endif
+#ifndef AW_FAULT_SCAN_CHUNK
+#define AW_FAULT_SCAN_CHUNK 6
+#endif
+
+#define AW_FAULT_MAP_BYTES ((AW_MAX_LEDS + 7u) / 8u)
+
+// Result of an open/short scan: one bit per LED channel, indexed like the
+// framebuffer (y * 18 + x * 3 + channel). Unpopulated channels stay clear.
+struct AwFaultMap
+{
+    uint8_t open[AW_FAULT_MAP_BYTES];    // LED not conducting
+    uint8_t shorted[AW_FAULT_MAP_BYTES]; // LED shorted
+
+    inline bool isOpen(uint8_t x, uint8_t y, AwChannel ch) const
+    {
+        return _bit(open, x, y, ch);
+    }
+
+    inline bool isShort(uint8_t x, uint8_t y, AwChannel ch) const
+    {
+        return _bit(shorted, x, y, ch);
+    }
+
+    // Number of faulty channels (open and short counted separately).
+    uint16_t count() const
+    {
+        uint16_t n = 0;
+        for (uint8_t i = 0; i < AW_FAULT_MAP_BYTES; i++)
+        {
+            for (uint8_t v = open[i]; v; v &= (uint8_t)(v - 1u))
+                n++;
+            for (uint8_t v = shorted[i]; v; v &= (uint8_t)(v - 1u))
+                n++;
+        }
+        return n;
+    }
+
+    static inline bool _bit(const uint8_t *bits, uint8_t x, uint8_t y, AwChannel ch)
+    {
+        const uint16_t led = (uint16_t)y * 18u + x * 3u + (uint8_t)ch;
+        return led < AW_MAX_LEDS && (bits[led >> 3] & (uint8_t)(1u << (led & 7u)));
+    }
+};
+
+// Byte-wise accessors for calibration storage (EEPROM, NVS, flash...).
+typedef uint8_t (*AwCalReadFn)(uint16_t offset, void *ctx);
+typedef void (*AwCalWriteFn)(uint16_t offset, uint8_t value, void *ctx);
+
+// Delta show(): a run of up to this many unchanged PWM bytes between two
+// changed ones is re-sent instead of opening a new write frame, since a new
+// frame costs a command + address header and a CS toggle.
+#ifndef AW_DELTA_MERGE_GAP
+#define AW_DELTA_MERGE_GAP 3
+#endif
+
 #define AW_BASE_Y(y) (((uint8_t)(y) * 18u))
 #define AW_BASE_X(x) (((uint8_t)(x) * 3u))
 #define AW_BASE_INDEX(x, y) (uint8_t)(AW_BASE_Y(y) + AW_BASE_X(x))
 
+// Driver storage for a panel of `rows` rows: two PWM frames (drawing buffer
+// and chip shadow), the Page 3 copy (6 registers per row), plus the scaling
+// buffer and the SPI scratch when they are compiled in.
+#define AW_DRIVER_RAM(rows)                                              \
+    ((uint16_t)AW_BASE_Y(rows) * (2u + (AW_ENABLE_SCALING_BUFFER ? 1u : 0u) + \
+                                  (AW_NEEDS_SPI_SCRATCH ? 1u : 0u)) +    \
+     (uint16_t)(rows) * 6u)
+
+// Storage of a driver that only ever streams an indexed frame (see
+// AW20216SIndexed): the Page 3 copy and the SPI scratch, without the two PWM
+// frames or the scaling buffer.
+#define AW_DRIVER_RAM_INDEXED(rows)                                       \
+    ((uint16_t)AW_BASE_Y(rows) * (AW_NEEDS_SPI_SCRATCH ? 1u : 0u) +        \
+     (uint16_t)(rows) * 6u)
+
 #define AW_CMD_WRITE_PAGE(page) (uint8_t)(AW_CHIPID_SPI | ((page & 0x07) << 1) | 0x00)
 #define AW_CMD_READ_PAGE(page) (uint8_t)(AW_CHIPID_SPI | ((page & 0x07) << 1) | 0x01)
 
@@ -143,40 +337,71 @@ enum class AwPattern : uint8_t {
 #define AW_PAT_T_BASE(idx) (uint8_t)( (uint8_t)AW_REG_PAT0T0 + ((uint8_t)(idx) * 4u))
 #define AW_PAT_CFG_ADDR(idx) (uint8_t)( (uint8_t)AW_REG_PAT0CFG + (uint8_t)(idx))
 
-//* AW20216S Class Definition */
+// Channel selection bits (see setChannelPatternMask()).
+#define AW_CH_MASK(ch) (uint8_t)(1u << (uint8_t)(ch))
+#define AW_CH_RGB      0x07
 
-class AW20216S
+//* AW20216SBase Class Definition */
+
+/**
+ * Driver logic shared by AW20216S (storage for all 12 rows) and AW20216ST
+ * (storage and geometry fixed at compile time). It works on a storage block
+ * handed in by the derived class and is not constructed directly.
+ */
+class AW20216SBase
 {
 public:
-    /**
-     * @brief Construct the driver for one AW20216S device.
-     *
-     * Stores the geometry and SPI configuration but does NOT touch the
-     * hardware yet; call begin() before any other method.
-     *
-     * @param rows    Number of rows (SWy lines) wired to the matrix.
-     *                For the LMX2 6x12 RGB panel this is 12. Valid range 1-12.
-     * @param cols    Number of columns (RGB triplets / CSx groups).
-     *                For the LMX2 6x12 RGB panel this is 6. Valid range 1-6.
-     * @param csPin   MCU GPIO used as Chip Select (active LOW).
-     *                Typical values: 10 on Arduino UNO, 5 or 15 on ESP32.
-     * @param spiPort SPI bus instance to drive the chip. Defaults to the
-     *                board's primary `SPI`. Pass e.g. `SPI1` / `HSPI` on MCUs
-     *                that expose several SPI peripherals.
-     */
-    AW20216S(uint8_t rows, uint8_t cols, uint8_t csPin, SPIClass &spiPort = SPI);
+    // The framebuffers are addressed through internal pointers: not copyable.
+    AW20216SBase(const AW20216SBase &) = delete;
+    AW20216SBase &operator=(const AW20216SBase &) = delete;
 
     /**
      * @brief Initialize the chip and bring it to a usable default state.
      *
-     * Sets CS as output, starts the SPI bus, performs a software reset,
-     * enables the device (GCR) and applies a safe default global current.
+     * Sets CS as output, starts the SPI bus (or the transport), performs a
+     * software reset, enables the device (GCR) and applies a safe default
+     * global current.
      *
      * @return true  if communication succeeded (GCR read back as expected).
      * @return false if the chip did not acknowledge (check wiring / CS pin).
      */
     bool begin();
 
+    /**
+     * @brief Talk to the chip through a transport instead of the SPI port
+     *        and CS pin given to the constructor.
+     *
+     * Call before begin(). showAsync() runs synchronously on a transport.
+     *
+     * @param transport Bit-banged, recording or custom bus (see
+     *                  AW20216STransport.h), or nullptr for hardware SPI.
+     *                  Must outlive the driver.
+     */
+    inline void setTransport(AwTransport *transport) { _transport = transport; }
+
+    /** @brief Transport in use, or nullptr for hardware SPI. */
+    inline AwTransport *transport() const { return _transport; }
+
+    /**
+     * @brief Change how many rows (SW lines) the chip scans.
+     *
+     * Updates SWSEL in GCR and the framebuffer bounds. With fewer SW lines
+     * in the time-division scan each row gets a larger duty share, so a
+     * shorter panel is brighter at the same global current and flickers
+     * less. Framebuffer rows that fall outside the new range are cleared
+     * (sent to the chip by the next show()).
+     *
+     * @param rows Active rows, 1-12, clamped to the rows the driver's
+     *             storage was sized for. Call after begin(); begin()
+     *             itself scans the rows passed to the constructor.
+     */
+    void setActiveRows(uint8_t rows);
+
+    /**
+     * @brief Number of rows currently scanned (and drawable).
+     */
+    inline uint8_t activeRows() const { return _rows; }
+
     /**
      * @brief Perform a software reset, restoring power-on register defaults.
      *
@@ -200,6 +425,23 @@ public:
      */
     void fillScreen(uint8_t r, uint8_t g, uint8_t b);
 
+    /**
+     * @brief Pass every PWM byte through a color correction table on its way
+     *        to the chip.
+     *
+     * The framebuffer keeps linear values; the table is applied while the
+     * bytes are streamed out by show(), showAsync(), showWithScaling() and
+     * AW20216SArray::showAll(), so it costs no extra pass over the frame
+     * and no second buffer. The next show() resends the whole frame.
+     *
+     * @param lut 3 x 256 bytes in PROGMEM (R, G, B), normally
+     *            AwColorLut<gamma, whiteR, whiteG, whiteB, cap>::table;
+     *            nullptr sends the framebuffer unchanged (default).
+     * @note On DMA cores (AW_HAS_SPI_ASYNC_TRANSFER) showAsync() blocks
+     *       while a table is set, since DMA cannot translate on the fly.
+     */
+    void setOutputLut(const uint8_t *lut);
+
     /**
      * @brief Set the global current (master brightness) shared by all LEDs.
      *
@@ -226,183 +468,1251 @@ public:
     void setPixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b);
 
     /**
-     * @brief Push the whole framebuffer to the chip (Page 1) in one burst.
+     * @brief Fill a rectangle of the framebuffer with one RGB color.
      *
-     * Sends the 216 PWM bytes in a single SPI transaction. Call this after
-     * setPixel/fillScreen/clearScreen to make the changes visible.
+     * Clipped to the panel; the origin may be negative (partly off-screen).
+     * Each row of the panel is a contiguous 18-byte slice of the
+     * framebuffer, so this writes whole row spans instead of calling
+     * setPixel() per pixel.
+     *
+     * @param x Left column (may be negative).
+     * @param y Top row (may be negative).
+     * @param w Width in pixels.
+     * @param h Height in pixels.
+     * @param r Red   PWM value, 0-255.
+     * @param g Green PWM value, 0-255.
+     * @param b Blue  PWM value, 0-255.
+     * @note RAM-only operation. Call show() to make it visible.
      */
-    void show();
+    void fillRect(int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t r, uint8_t g, uint8_t b);
 
     /**
-     * @brief Set the per-channel scaling (current trim) for white balance.
+     * @brief Draw a horizontal line of w pixels starting at (x, y). Clipped.
+     * @note RAM-only operation. Call show() to make it visible.
+     */
+    void drawHLine(int16_t x, int16_t y, uint8_t w, uint8_t r, uint8_t g, uint8_t b);
+
+    /**
+     * @brief Draw a vertical line of h pixels starting at (x, y). Clipped.
+     * @note RAM-only operation. Call show() to make it visible.
+     */
+    void drawVLine(int16_t x, int16_t y, uint8_t h, uint8_t r, uint8_t g, uint8_t b);
+
+    /**
+     * @brief Copy an RGB image into the framebuffer.
      *
-     * Applies the same scaling to every pixel and writes Page 2 immediately
-     * over SPI (does not use the framebuffer).
+     * The image is row-major, 3 bytes (R, G, B) per pixel, w * h * 3 bytes.
+     * Clipped to the panel; each visible row is one memcpy.
      *
-     * @param r_scale Red   channel scale, 0 (off) - 255 (no attenuation).
-     * @param g_scale Green channel scale, 0 (off) - 255 (no attenuation).
-     * @param b_scale Blue  channel scale, 0 (off) - 255 (no attenuation).
-     * @note Final brightness ≈ globalCurrent x scaling x PWM. Set to
-     *       (0xFF, 0xFF, 0xFF) for full output, then lower a channel to
-     *       correct the white point.
+     * @param x   Column of the image's left edge (may be negative).
+     * @param y   Row of the image's top edge (may be negative).
+     * @param w   Image width in pixels.
+     * @param h   Image height in pixels.
+     * @param rgb Image bytes in RAM.
+     * @note RAM-only operation. Call show() to make it visible.
      */
-    void setScaling(uint8_t r_scale, uint8_t g_scale, uint8_t b_scale);
+    void blitRGB(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *rgb);
 
-    /** PWM support */
+    /**
+     * @brief Same as blitRGB() with the image in flash (PROGMEM).
+     */
+    void blitRGB_P(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *rgb);
 
     /**
-     * @brief Low-level write of the raw PCCR register (PWM clock control).
+     * @brief Draw a 1-bit bitmap in one color; clear bits are left untouched.
      *
-     * Reserved bits [4:2] are masked off before writing.
+     * Rows are (w + 7) / 8 bytes each, most significant bit = leftmost
+     * pixel (the usual GFX bitmap layout). Clipped to the panel.
      *
-     * @param pccr Raw register value. Bits [7:5] = PWM frequency divider,
-     *             bits [1:0] = PWM phase. Prefer setPwmFrequency() unless
-     *             you need direct register access.
+     * @param x    Column of the bitmap's left edge (may be negative).
+     * @param y    Row of the bitmap's top edge (may be negative).
+     * @param w    Bitmap width in pixels.
+     * @param h    Bitmap height in pixels.
+     * @param bits Bitmap bytes in RAM.
+     * @param r    Red   PWM value of set bits, 0-255.
+     * @param g    Green PWM value of set bits, 0-255.
+     * @param b    Blue  PWM value of set bits, 0-255.
+     * @note RAM-only operation. Call show() to make it visible.
      */
-    void setPwmClock(uint8_t pccr);
+    void blit1bpp(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bits,
+                  uint8_t r, uint8_t g, uint8_t b);
 
     /**
-     * @brief Configure the PWM frequency and phase via the PCCR register.
+     * @brief Same as blit1bpp() with the bitmap in flash (PROGMEM).
+     */
+    void blit1bpp_P(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bits,
+                    uint8_t r, uint8_t g, uint8_t b);
+
+    /**
+     * @brief Shift the framebuffer contents in place.
      *
-     * @param freq  PWM frequency (AwPwmFreq), from High = 62.5 kHz down to
-     *              Low = 488 Hz. Higher frequencies reduce visible flicker,
-     *              especially when filming the panel.
-     * @param phase PWM phase / delay scheme (AwPwmPhase). Default PhaseDelay
-     *              staggers channels to lower peak current; the alternatives
-     *              invert or split the phase across drivers.
+     * Rows move with one memmove, columns with one memmove per row; the
+     * pixels uncovered on the opposite edge are filled with (r, g, b).
+     *
+     * @param dx Columns to shift right (negative: left).
+     * @param dy Rows to shift down (negative: up).
+     * @param r  Red   fill value, 0-255 (default 0).
+     * @param g  Green fill value, 0-255 (default 0).
+     * @param b  Blue  fill value, 0-255 (default 0).
+     * @note RAM-only operation. Call show() to make it visible.
      */
-    void setPwmFrequency(AwPwmFreq freq, AwPwmPhase phase = AwPwmPhase::PhaseDelay);
+    void scroll(int8_t dx, int8_t dy, uint8_t r = 0, uint8_t g = 0, uint8_t b = 0);
 
-    /** Breathing support */
+    /**
+     * @brief Copy the framebuffer out, e.g. to keep a rendered scene as the
+     *        source or target of a crossfade.
+     *
+     * @param out AW_FRAME_SIZE(rows) bytes.
+     */
+    void captureFrame(uint8_t *out) const;
 
     /**
-     * @brief Configure the timing of one breathing engine (PATx) and enable it.
+     * @brief Framebuffer = from + (to - from) * t / 255, per channel.
      *
-     * Enables the engine in autonomous mode. The four phases form one breath
-     * cycle: rise (T0) -> hold high (T1) -> fall (T2) -> hold low (T3).
+     * Works on 4 bytes per 32-bit word (two 16-bit lanes per multiply), so
+     * a full frame costs a few hundred cycles; call it once per frame with
+     * a rising t, then show(), for a per-pixel crossfade that leaves the
+     * global current alone.
      *
-     * @param pat         Pattern engine to configure: PAT0, PAT1 or PAT2.
-     *                    Passing PWM is ignored (no engine).
-     * @param t0          Phase 0 rise time (dim -> bright), 0-255.
-     * @param t1          Phase 1 on time (hold at max), 0-255.
-     * @param t2          Phase 2 fall time (bright -> dim), 0-255.
-     * @param t3          Phase 3 off time (hold at min), 0-255.
-     *                    Larger values mean longer phases (slower breathing).
-     * @param logarithmic true  -> logarithmic ramp (perceptually smoother);
-     *                    false -> linear ramp (default).
+     * @param from Source frame, AW_FRAME_SIZE(rows) bytes (t = 0).
+     * @param to   Target frame, AW_FRAME_SIZE(rows) bytes (t = 255).
+     * @param t    Position, 0-255; 255 gives exactly `to`.
+     * @note RAM-only operation. Call show() to make it visible. Either
+     *       frame may be a captureFrame() copy; neither may be modified
+     *       through the framebuffer.
      */
-    void configureBreathing(
-        AwPattern pat,
-        uint8_t t0,
-        uint8_t t1,
-        uint8_t t2,
-        uint8_t t3,
-        bool logarithmic = false);
+    void crossfade(const uint8_t *from, const uint8_t *to, uint8_t t);
 
     /**
-     * @brief Assign a single color channel of one pixel to a breathing pattern.
+     * @brief Add a frame onto the framebuffer, saturating at 255.
      *
-     * Out-of-range coordinates are ignored (no-op).
+     * @param src AW_FRAME_SIZE(rows) bytes.
+     * @note RAM-only operation. Call show() to make it visible.
+     */
+    void blendAdd(const uint8_t *src);
+
+    /**
+     * @brief Keep the brighter of the framebuffer and a frame, per channel.
      *
-     * @param x   Column index, 0 - (cols-1) (0-5 on the 6x12 panel).
-     * @param y   Row index,    0 - (rows-1) (0-11 on the 6x12 panel).
-     * @param ch  Channel to drive: AwChannel::R, ::G or ::B.
-     * @param pat Pattern to bind: PWM (direct control, no breathing),
-     *            PAT0, PAT1 or PAT2.
+     * @param src AW_FRAME_SIZE(rows) bytes.
+     * @note RAM-only operation. Call show() to make it visible.
      */
-    void setChannelPattern(uint8_t x, uint8_t y, AwChannel ch, AwPattern pat);
+    void blendMax(const uint8_t *src);
 
     /**
-     * @brief Assign breathing patterns to the R, G and B channels of one pixel.
+     * @brief Show a window of a wider virtual canvas kept in a ring buffer.
      *
-     * Convenience wrapper that calls setChannelPattern() for each channel.
+     * While a viewport is set, show() (and showAsync(),
+     * AW20216SArray::showAll()) stream the cols x rows window starting at
+     * the viewport origin straight from the ring to Page 1, without
+     * composing it into the framebuffer. A marquee then only draws the
+     * column that scrolls in and moves the origin. Several chips can share
+     * one ring with different origins.
      *
-     * @param x    Column index, 0 - (cols-1) (0-5 on the 6x12 panel).
-     * @param y    Row index,    0 - (rows-1) (0-11 on the 6x12 panel).
-     * @param rPat Pattern for the Red   channel: PWM, PAT0, PAT1 or PAT2.
-     * @param gPat Pattern for the Green channel: PWM, PAT0, PAT1 or PAT2.
-     * @param bPat Pattern for the Blue  channel: PWM, PAT0, PAT1 or PAT2.
+     * @param ring     AW_VIEWPORT_SIZE(rows, ringCols) bytes, row-major RGB;
+     *                 nullptr returns to the normal framebuffer.
+     * @param ringCols Width of the virtual canvas in pixels (>= cols).
+     * @return false if ringCols is smaller than the panel width.
      */
-    void setPixelPatternRGB(uint8_t x, uint8_t y, AwPattern rPat, AwPattern gPat, AwPattern bPat);
+    bool setViewport(uint8_t *ring, uint16_t ringCols);
 
     /**
-     * @brief Set the brightness envelope (min/max) of a breathing engine.
+     * @brief Set the ring column shown at the panel's left edge (wraps).
+     */
+    void setViewportOrigin(uint16_t vx);
+
+    /**
+     * @brief Move the viewport origin by dx columns (wraps).
+     */
+    void scrollViewport(int16_t dx);
+
+    /**
+     * @brief Ring column currently shown at the panel's left edge.
+     */
+    inline uint16_t viewportOrigin() const { return _viewX; }
+
+    /**
+     * @brief Write one pixel of the viewport ring.
      *
-     * @param pat  Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
-     * @param minV Minimum brightness at the bottom of the breath, 0-255.
-     * @param maxV Maximum brightness at the top of the breath, 0-255.
-     *             Keep minV < maxV for a visible breathing effect.
+     * @param vx Ring column (taken modulo the ring width).
+     * @param y  Row, 0 - (rows-1); out of range is ignored.
+     * @param r  Red   PWM value, 0-255.
+     * @param g  Green PWM value, 0-255.
+     * @param b  Blue  PWM value, 0-255.
      */
-    void setBreathingBrightness(AwPattern pat, uint8_t minV, uint8_t maxV);
+    void setViewportPixel(uint16_t vx, uint8_t y, uint8_t r, uint8_t g, uint8_t b);
 
     /**
-     * @brief Enable or disable a breathing pattern engine (writes PATxCFG).
+     * @brief Fill one whole column of the viewport ring (e.g. to blank the
+     *        column about to scroll in).
+     */
+    void fillViewportColumn(uint16_t vx, uint8_t r, uint8_t g, uint8_t b);
+
+    /**
+     * @brief Drive the panel from a palette-indexed frame.
      *
-     * @param pat    Pattern engine: PAT0, PAT1 or PAT2.
-     * @param enable true to enable the engine, false to disable it.
+     * While an indexed frame is set, show() (and showAsync(),
+     * AW20216SArray::showAll()) stream every pixel's palette color to
+     * Page 1, expanded row by row on the way out, instead of the RGB
+     * framebuffer. Pixel data is 4x (4 bpp) or 3x (8 bpp) smaller, and
+     * editing a palette entry recolors every pixel that uses it.
+     *
+     * @param pixels  AW_INDEXED_SIZE(rows, bpp) bytes; nullptr returns to
+     *                the RGB framebuffer.
+     * @param bpp     Bits per pixel, 4 or 8.
+     * @param palette entries x 3 bytes (R, G, B) in RAM.
+     * @param entries Palette size; larger indices show black.
+     * @return false if bpp is not 4 or 8, or nullptr was passed to a driver
+     *         without an RGB framebuffer (AW20216SIndexed).
+     * @note The viewport, when set, takes precedence. The whole frame is
+     *       sent by every show() (there is no delta in this mode).
      */
-    void enableBreathing(AwPattern pat, bool enable);
+    bool setIndexedFrame(uint8_t *pixels, uint8_t bpp, uint8_t *palette, uint16_t entries);
 
     /**
-     * @brief Trigger / restart the breathing animation of a pattern engine.
+     * @brief Write one pixel of the indexed frame.
      *
-     * Sets the matching bit in the PATGO register.
+     * @param x   Column, 0 - (cols-1); out of range is ignored.
+     * @param y   Row, 0 - (rows-1); out of range is ignored.
+     * @param idx Palette index (masked to bpp bits).
+     * @note RAM-only operation. Call show() to make it visible.
+     */
+    void setIndex(uint8_t x, uint8_t y, uint8_t idx);
+
+    /**
+     * @brief Read back one pixel of the indexed frame (0 if out of range).
+     */
+    uint8_t getIndex(uint8_t x, uint8_t y) const;
+
+    /**
+     * @brief Set every pixel of the indexed frame to one palette index.
+     * @note RAM-only operation. Call show() to make it visible.
+     */
+    void fillIndex(uint8_t idx);
+
+    /**
+     * @brief Change one palette entry.
      *
-     * @param pat Pattern engine to start: PAT0, PAT1 or PAT2 (PWM ignored).
+     * @param i Entry, below the palette size (ignored otherwise).
+     * @param r Red   PWM value, 0-255.
+     * @param g Green PWM value, 0-255.
+     * @param b Blue  PWM value, 0-255.
+     * @note RAM-only operation. Call show() to make it visible.
      */
-    void startBreathing(AwPattern pat);
+    void setPaletteColor(uint8_t i, uint8_t r, uint8_t g, uint8_t b);
 
-    /** Extra advanced functions */
+    /**
+     * @brief Color-cycle a range of palette entries by one step.
+     *
+     * Entry first + k takes the color of entry first + k + 1 (the first one
+     * wraps to the end), or the reverse with down. Pixel data is untouched.
+     *
+     * @param first First entry of the range.
+     * @param count Entries in the range (clipped to the palette).
+     * @param down  Rotate the other way.
+     * @note RAM-only operation. Call show() to make it visible.
+     */
+    void rotatePalette(uint8_t first, uint8_t count, bool down = false);
 
     /**
-     * @brief Low-level: write one raw byte to any register on any page.
+     * @brief Push the framebuffer changes to the chip (Page 1).
      *
-     * @param page  Target page: AW20216S_PAGE0..PAGE4 (0-4).
-     * @param reg   Register address within the page (0x00-0xFF).
-     * @param value Byte to write.
+     * The driver remembers what the chip last received, so only the PWM
+     * bytes that differ are sent: each changed run becomes one burst frame
+     * (runs separated by a few unchanged bytes are merged, see
+     * AW_DELTA_MERGE_GAP), all inside a single SPI transaction. An unchanged
+     * frame costs no SPI traffic at all. Call this after
+     * setPixel/fillScreen/clearScreen to make the changes visible.
      */
-    void writeRegister(uint8_t page, uint8_t reg, uint8_t value);
+    void show();
 
     /**
-     * @brief Low-level: read one raw byte from any register on any page.
+     * @brief Forget what the chip is currently showing.
      *
-     * @param page Target page: AW20216S_PAGE0..PAGE4 (0-4).
-     * @param reg  Register address within the page (0x00-0xFF).
-     * @return The byte currently stored in that register.
+     * The next show() resends all 216 PWM bytes. Use it if Page 1 was
+     * changed behind the driver's back (e.g. the chip was power-cycled).
      */
-    uint8_t readRegister(uint8_t page, uint8_t reg);
+    void invalidate();
 
-private:
-    uint8_t _csPin;       // MCU GPIO used as Chip Select (active LOW)
-    SPIClass *_spiPort;   // SPI bus instance driving the chip
-    uint8_t _currentPage; // Last page selected, to skip redundant page commands
-    uint8_t _rows;        // Number of rows (SWy lines), 1-12
-    uint8_t _cols;        // Number of columns (RGB triplets), 1-6
+    /**
+     * @brief Start sending the whole framebuffer to the chip and return.
+     *
+     * On cores with AW_HAS_SPI_ASYNC_TRANSFER (opt-in, e.g. the Adafruit
+     * SAMD core) the drawing buffer is swapped with the buffer the chip last
+     * received (no copy) and streamed to Page 1 on DMA; the call returns
+     * while the burst is on the wire, so the next frame can be rendered
+     * meanwhile.
+     *
+     * Everywhere else, including ESP32 and stock SAMD cores, and with an
+     * output table, viewport, indexed frame or transport, this BLOCKS and
+     * is exactly show(): nothing is taken off the render path and the
+     * framebuffer is not swapped.
+     *
+     * @note After a DMA swap the framebuffer holds the frame BEFORE the one
+     *       just sent. Redraw the whole frame (or clearScreen()) before the
+     *       next showAsync(). Any other SPI call first waits for the burst.
+     */
+    void showAsync();
 
-    // Local framebuffer: 12 rows * 18 channels (6 R + 6 G + 6 B) = 216 bytes.
-    uint8_t _frameBuffer[AW_MAX_LEDS];
+    /**
+     * @brief Check whether a showAsync() burst is still on the wire.
+     *
+     * @return true while the DMA transfer is running (always false on cores
+     *         without AW_HAS_SPI_ASYNC_TRANSFER).
+     */
+    bool isBusy();
 
-#if AW_HAS_SPI_BULK_TRANSFER
-    uint8_t _spiScratch[AW_MAX_LEDS]; // Copy buffer so the full-duplex bulk
-                                      // transfer never clobbers _frameBuffer
-#endif
+    /**
+     * @brief Block until the pending showAsync() burst has finished.
+     *
+     * Returns immediately when nothing is in flight.
+     */
+    void waitShow();
 
+#if AW_ENABLE_STATS
     /**
-     * @brief Burst-write a contiguous block of bytes to one page in a single
-     *        SPI transaction, starting at register address 0x00.
-     * @param page Target page (0-4).
-     * @param data Source bytes to send.
-     * @param len  Number of bytes to send.
+     * @brief Driver counters since construction / resetStats().
+     *
+     * Counts every SPI transaction and command frame this driver opens, the
+     * bytes clocked per page, the time the bus was held and how long show()
+     * took. Only compiled with -DAW_ENABLE_STATS=1.
+     *
+     * @return Reference to the live counters.
+     * @note A showAsync() burst is timed until waitShow()/isBusy() releases
+     *       the bus. Panels flushed by AW20216SArray::showAll() in a shared
+     *       transaction count their frames and bytes, while the transaction
+     *       and its time go to the panel that opened it.
      */
-    void _writePageBurst(uint8_t page, const uint8_t *data, uint16_t len);
+    inline const AwDriverStats &getStats() const { return _stats; }
 
     /**
-     * @brief Zero the whole framebuffer (RAM only, does not touch the chip).
+     * @brief Zero all counters, including the worst show() time.
+     */
+    void resetStats();
+#endif
+
+    /**
+     * @brief Set the per-channel scaling (current trim) for white balance.
+     *
+     * Applies the same scaling to every pixel and writes Page 2 immediately
+     * in one burst (does not use the framebuffer). With the scaling buffer
+     * enabled the buffer is refilled too.
+     *
+     * @param r_scale Red   channel scale, 0 (off) - 255 (no attenuation).
+     * @param g_scale Green channel scale, 0 (off) - 255 (no attenuation).
+     * @param b_scale Blue  channel scale, 0 (off) - 255 (no attenuation).
+     * @note Final brightness ≈ globalCurrent x scaling x PWM. Set to
+     *       (0xFF, 0xFF, 0xFF) for full output, then lower a channel to
+     *       correct the white point.
+     */
+    void setScaling(uint8_t r_scale, uint8_t g_scale, uint8_t b_scale);
+
+#if AW_ENABLE_SCALING_BUFFER
+    // Drivers built on indexed-only storage (AW20216SIndexed) have no scaling
+    // buffer: there the calls below do nothing (the calibration calls return
+    // 0 / false) and only the uniform setScaling() applies.
+
+    /**
+     * @brief Set the scaling (current trim) of one pixel in the scaling buffer.
+     *
+     * Out-of-range coordinates are ignored (no-op).
+     *
+     * @param x       Column index, 0 - (cols-1) (0-5 on the 6x12 panel).
+     * @param y       Row index,    0 - (rows-1) (0-11 on the 6x12 panel).
+     * @param r_scale Red   channel scale, 0 (off) - 255 (no attenuation).
+     * @param g_scale Green channel scale, 0 (off) - 255 (no attenuation).
+     * @param b_scale Blue  channel scale, 0 (off) - 255 (no attenuation).
+     * @note RAM-only operation. Call showWithScaling() to push it.
+     */
+    void setPixelScaling(uint8_t x, uint8_t y, uint8_t r_scale, uint8_t g_scale, uint8_t b_scale);
+
+    /**
+     * @brief Push PWM and scaling of every LED in one transaction (Page 4).
+     *
+     * Streams the framebuffer and the scaling buffer interleaved (PWM, SL per
+     * LED, 432 bytes) through the virtual Page 4, so color and per-pixel
+     * current change on the same refresh with no tearing between them.
+     */
+    void showWithScaling();
+
+    /**
+     * @brief Push the whole scaling buffer to Page 2 in one burst.
+     */
+    void showScaling();
+
+    /**
+     * @brief Set one pixel with 16 bits per channel (deep dimming).
+     *
+     * Brightness is PWM x scaling, so each 16-bit value is factored into a
+     * (PWM, SL) pair through a compile-time table and stored in the
+     * framebuffer and the scaling buffer. The darkest step is 1/65025 of
+     * full scale instead of 1/255, with no temporal dithering. Out-of-range
+     * coordinates are ignored.
+     *
+     * @param x Column index, 0 - (cols-1).
+     * @param y Row index,    0 - (rows-1).
+     * @param r Red   intensity, 0 (off) - 65535 (full, linear).
+     * @param g Green intensity, 0 (off) - 65535.
+     * @param b Blue  intensity, 0 (off) - 65535.
+     * @note RAM-only operation. Push with showWithScaling(), which sends PWM
+     *       and SL of every LED in the same burst. It overwrites the pixel's
+     *       scaling (fold white balance into the values) and leaves no room
+     *       for an output table: keep setOutputLut(nullptr) in this mode.
+     */
+    void setPixel16(uint8_t x, uint8_t y, uint16_t r, uint16_t g, uint16_t b);
+
+    /**
+     * @brief Fill the panel with one 16-bit-per-channel color.
+     *
+     * @param r Red   intensity, 0-65535.
+     * @param g Green intensity, 0-65535.
+     * @param b Blue  intensity, 0-65535.
+     * @note RAM-only operation. Call showWithScaling() to apply.
+     */
+    void fillScreen16(uint16_t r, uint16_t g, uint16_t b);
+
+    /**
+     * @brief Size in bytes of this panel's calibration blob.
+     */
+    uint16_t calibrationSize() const;
+
+    /**
+     * @brief Export the scaling buffer as a calibration blob into RAM.
+     *
+     * @param out    Destination buffer.
+     * @param maxLen Capacity of out; must be at least calibrationSize().
+     * @return Bytes written, or 0 if out is too small.
+     */
+    uint16_t saveCalibration(uint8_t *out, uint16_t maxLen) const;
+
+    /**
+     * @brief Export the scaling buffer as a calibration blob, byte by byte.
+     *
+     * @param write Called once per blob byte with its offset (e.g. an
+     *              EEPROM.update() / NVS wrapper).
+     * @param ctx   Passed through to write.
+     * @return Bytes written (calibrationSize()).
+     */
+    uint16_t saveCalibration(AwCalWriteFn write, void *ctx = nullptr) const;
+
+    /**
+     * @brief Load a calibration blob from RAM into the scaling buffer.
+     *
+     * The blob is rejected (buffer untouched) if the magic, version,
+     * geometry or CRC do not match.
+     *
+     * @param blob Blob bytes.
+     * @param len  Blob length.
+     * @return true if the blob was valid and loaded.
+     * @note RAM-only operation. Call showScaling() or showWithScaling().
+     */
+    bool loadCalibration(const uint8_t *blob, uint16_t len);
+
+    /**
+     * @brief Load a calibration blob stored in flash (PROGMEM).
+     *
+     * @param blob PROGMEM address of the blob.
+     * @param len  Blob length.
+     * @return true if the blob was valid and loaded.
+     * @note RAM-only operation. Call showScaling() or showWithScaling().
+     */
+    bool loadCalibration_P(const uint8_t *blob, uint16_t len);
+
+    /**
+     * @brief Load a calibration blob byte by byte (EEPROM, NVS...).
+     *
+     * @param read Returns the blob byte at a given offset.
+     * @param len  Blob length available in the storage.
+     * @param ctx  Passed through to read.
+     * @return true if the blob was valid and loaded.
+     * @note RAM-only operation. Call showScaling() or showWithScaling().
+     */
+    bool loadCalibration(AwCalReadFn read, uint16_t len, void *ctx = nullptr);
+#endif
+
+    /** PWM support */
+
+    /**
+     * @brief Low-level write of the raw PCCR register (PWM clock control).
+     *
+     * Reserved bits [4:2] are masked off before writing.
+     *
+     * @param pccr Raw register value. Bits [7:5] = PWM frequency divider,
+     *             bits [1:0] = PWM phase. Prefer setPwmFrequency() unless
+     *             you need direct register access.
+     */
+    void setPwmClock(uint8_t pccr);
+
+    /**
+     * @brief Configure the PWM frequency and phase via the PCCR register.
+     *
+     * @param freq  PWM frequency (AwPwmFreq), from High = 62.5 kHz down to
+     *              Low = 488 Hz. Higher frequencies reduce visible flicker,
+     *              especially when filming the panel.
+     * @param phase PWM phase / delay scheme (AwPwmPhase). Default PhaseDelay
+     *              staggers channels to lower peak current; the alternatives
+     *              invert or split the phase across drivers.
+     */
+    void setPwmFrequency(AwPwmFreq freq, AwPwmPhase phase = AwPwmPhase::PhaseDelay);
+
+    /** Breathing support */
+
+    /**
+     * @brief Configure the timing of one breathing engine (PATx) and enable it.
+     *
+     * Enables the engine in autonomous mode. The four phases form one breath
+     * cycle: rise (T0) -> hold high (T1) -> fall (T2) -> hold low (T3).
+     *
+     * @param pat         Pattern engine to configure: PAT0, PAT1 or PAT2.
+     *                    Passing PWM is ignored (no engine).
+     * @param t0          Phase 0 rise time (dim -> bright), 0-255.
+     * @param t1          Phase 1 on time (hold at max), 0-255.
+     * @param t2          Phase 2 fall time (bright -> dim), 0-255.
+     * @param t3          Phase 3 off time (hold at min), 0-255.
+     *                    Larger values mean longer phases (slower breathing).
+     * @param logarithmic true  -> logarithmic ramp (perceptually smoother);
+     *                    false -> linear ramp (default).
+     */
+    void configureBreathing(
+        AwPattern pat,
+        uint8_t t0,
+        uint8_t t1,
+        uint8_t t2,
+        uint8_t t3,
+        bool logarithmic = false);
+
+    /**
+     * @brief Program a whole breathing engine (timers, envelope and config)
+     *        in a single SPI burst.
+     *
+     * Same effect as configureBreathing() followed by
+     * setBreathingBrightness(), but the registers PWMHx .. PATxCFG are sent
+     * as one CS frame from the driver's Page 0 copy instead of two.
+     *
+     * @param pat         Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
+     * @param t0          Phase 0 rise time (dim -> bright), 0-255.
+     * @param t1          Phase 1 on time (hold at max), 0-255.
+     * @param t2          Phase 2 fall time (bright -> dim), 0-255.
+     * @param t3          Phase 3 off time (hold at min), 0-255.
+     * @param minV        Minimum brightness at the bottom of the breath, 0-255.
+     * @param maxV        Maximum brightness at the top of the breath, 0-255.
+     * @param logarithmic true -> logarithmic ramp; false -> linear (default).
+     */
+    void setupBreathing(
+        AwPattern pat,
+        uint8_t t0,
+        uint8_t t1,
+        uint8_t t2,
+        uint8_t t3,
+        uint8_t minV,
+        uint8_t maxV,
+        bool logarithmic = false);
+
+    /**
+     * @brief Assign a single color channel of one pixel to a breathing pattern.
+     *
+     * Written to the chip immediately (one 3-byte SPI write; the other
+     * channels of the register come from a RAM copy of Page 3). Out-of-range
+     * coordinates are ignored (no-op).
+     *
+     * @param x   Column index, 0 - (cols-1) (0-5 on the 6x12 panel).
+     * @param y   Row index,    0 - (rows-1) (0-11 on the 6x12 panel).
+     * @param ch  Channel to drive: AwChannel::R, ::G or ::B.
+     * @param pat Pattern to bind: PWM (direct control, no breathing),
+     *            PAT0, PAT1 or PAT2.
+     */
+    void setChannelPattern(uint8_t x, uint8_t y, AwChannel ch, AwPattern pat);
+
+    /**
+     * @brief Assign breathing patterns to the R, G and B channels of one pixel.
+     *
+     * All three channels share one Page 3 register, so this is a single
+     * 3-byte SPI write.
+     *
+     * @param x    Column index, 0 - (cols-1) (0-5 on the 6x12 panel).
+     * @param y    Row index,    0 - (rows-1) (0-11 on the 6x12 panel).
+     * @param rPat Pattern for the Red   channel: PWM, PAT0, PAT1 or PAT2.
+     * @param gPat Pattern for the Green channel: PWM, PAT0, PAT1 or PAT2.
+     * @param bPat Pattern for the Blue  channel: PWM, PAT0, PAT1 or PAT2.
+     */
+    void setPixelPatternRGB(uint8_t x, uint8_t y, AwPattern rPat, AwPattern gPat, AwPattern bPat);
+
+    /**
+     * @brief Assign breathing patterns to every pixel of a rectangle.
+     *
+     * The rectangle is clipped to the panel.
+     *
+     * @param x    Left column of the rectangle.
+     * @param y    Top row of the rectangle.
+     * @param w    Width in columns.
+     * @param h    Height in rows.
+     * @param rPat Pattern for the Red   channel: PWM, PAT0, PAT1 or PAT2.
+     * @param gPat Pattern for the Green channel: PWM, PAT0, PAT1 or PAT2.
+     * @param bPat Pattern for the Blue  channel: PWM, PAT0, PAT1 or PAT2.
+     * @note RAM-only operation. Call commitPatterns() to send it to the chip.
+     */
+    void setPatternRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+                        AwPattern rPat, AwPattern gPat, AwPattern bPat);
+
+    /**
+     * @brief Assign breathing patterns to the pixels selected by a mask.
+     *
+     * @param rowMasks One byte per row (rows entries); bit x set selects
+     *                 column x. Unselected pixels keep their pattern.
+     * @param rPat     Pattern for the Red   channel: PWM, PAT0, PAT1 or PAT2.
+     * @param gPat     Pattern for the Green channel: PWM, PAT0, PAT1 or PAT2.
+     * @param bPat     Pattern for the Blue  channel: PWM, PAT0, PAT1 or PAT2.
+     * @note RAM-only operation. Call commitPatterns() to send it to the chip.
+     */
+    void setPatternMask(const uint8_t *rowMasks, AwPattern rPat, AwPattern gPat, AwPattern bPat);
+
+    /**
+     * @brief Bind only some channels of the selected pixels to a pattern.
+     *
+     * Unlike setPatternMask(), the channels not named in channels keep
+     * their current assignment.
+     *
+     * @param rowMasks One byte per row (rows entries); bit x set selects
+     *                 column x. nullptr selects every pixel.
+     * @param channels AW_CH_MASK(AwChannel::R) | ... (AW_CH_RGB for all).
+     * @param pat      Pattern to bind: PWM, PAT0, PAT1 or PAT2.
+     * @note RAM-only operation. Call commitPatterns() to send it to the chip.
+     */
+    void setChannelPatternMask(const uint8_t *rowMasks, uint8_t channels, AwPattern pat);
+
+    /**
+     * @brief Assign the same breathing patterns to every pixel of the panel.
+     *
+     * @param rPat Pattern for the Red   channel: PWM, PAT0, PAT1 or PAT2.
+     * @param gPat Pattern for the Green channel: PWM, PAT0, PAT1 or PAT2.
+     * @param bPat Pattern for the Blue  channel: PWM, PAT0, PAT1 or PAT2.
+     * @note RAM-only operation. Call commitPatterns() to send it to the chip.
+     */
+    void setPatternAll(AwPattern rPat, AwPattern gPat, AwPattern bPat);
+
+    /**
+     * @brief Send the pattern assignments changed by setPatternRect(),
+     *        setPatternMask() or setPatternAll() to Page 3 in one burst.
+     *
+     * Does nothing if no pattern changed since the last commit.
+     */
+    void commitPatterns();
+
+    /**
+     * @brief Set the brightness envelope (min/max) of a breathing engine.
+     *
+     * @param pat  Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
+     * @param minV Minimum brightness at the bottom of the breath, 0-255.
+     * @param maxV Maximum brightness at the top of the breath, 0-255.
+     *             Keep minV < maxV for a visible breathing effect.
+     */
+    void setBreathingBrightness(AwPattern pat, uint8_t minV, uint8_t maxV);
+
+    /**
+     * @brief Enable or disable a breathing pattern engine (PATEN in PATxCFG).
+     *
+     * Only the PATEN bit changes; the mode and ramp set by
+     * configureBreathing() are kept.
+     *
+     * @param pat    Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
+     * @param enable true to enable the engine, false to disable it.
+     */
+    void enableBreathing(AwPattern pat, bool enable);
+
+    /**
+     * @brief Trigger / restart the breathing animation of a pattern engine.
+     *
+     * Sets the matching bit in the PATGO register.
+     *
+     * @param pat Pattern engine to start: PAT0, PAT1 or PAT2 (PWM ignored).
+     */
+    void startBreathing(AwPattern pat);
+
+    /** Extra advanced functions */
+
+    /**
+     * @brief Low-level: write one raw byte to any register on any page.
+     *
+     * @param page  Target page: AW20216S_PAGE0..PAGE4 (0-4).
+     * @param reg   Register address within the page (0x00-0xFF).
+     * @param value Byte to write.
+     */
+    void writeRegister(uint8_t page, uint8_t reg, uint8_t value);
+
+    /**
+     * @brief Low-level: write consecutive registers of one page in a single
+     *        SPI burst (the chip auto-increments the address).
+     *
+     * The driver's RAM copies of Pages 0, 1 and 3 are updated like
+     * writeRegister() does.
+     *
+     * @param page     Target page: AW20216S_PAGE0..PAGE4 (0-4).
+     * @param startReg First register address (0x00-0xFF).
+     * @param data     Bytes to write, one per register.
+     * @param len      Number of registers to write (at most AW_MAX_LEDS).
+     */
+    void writeRegisters(uint8_t page, uint8_t startReg, const uint8_t *data, uint16_t len);
+
+    /**
+     * @brief Low-level: read one raw byte from any register on any page.
+     *
+     * Always goes to the chip over SPI (the driver's RAM copies are not
+     * consulted), so it is the right call for diagnostics.
+     *
+     * @param page Target page: AW20216S_PAGE0..PAGE4 (0-4).
+     * @param reg  Register address within the page (0x00-0xFF).
+     * @return The byte currently stored in that register.
+     */
+    uint8_t readRegister(uint8_t page, uint8_t reg);
+
+    /**
+     * @brief Low-level: burst-read consecutive registers of one page.
+     *
+     * One SPI frame (command, start address, then len bytes clocked in) in
+     * one transaction; the chip auto-increments the address. Like
+     * readRegister() it always goes to the chip.
+     *
+     * @param page     Target page: AW20216S_PAGE0..PAGE4 (0-4).
+     * @param startReg First register address (0x00-0xFF).
+     * @param buf      Receives len bytes.
+     * @param len      Number of registers to read.
+     */
+    void readRegisters(uint8_t page, uint8_t startReg, uint8_t *buf, uint16_t len);
+
+    /**
+     * @brief Run an open and a short detection pass and decode the result.
+     *
+     * For each pass, enables detection in GCR, waits AW_FAULT_SETTLE_US and
+     * reads the OSR block of the scanned rows in one burst. GCR is restored
+     * afterwards. Only channels the chip is driving are tested, so light the
+     * panel (non-zero PWM and scaling) first. Blocks for about twice
+     * AW_FAULT_SETTLE_US.
+     *
+     * @param map Receives one open and one short bit per channel.
+     * @return Number of faulty channels (map.count()).
+     */
+    uint16_t scanFaults(AwFaultMap &map);
+
+    /**
+     * @brief Start the same scan spread over pollFaultScan() calls.
+     *
+     * Each poll does at most one short SPI operation (a GCR write or a read
+     * of AW_FAULT_SCAN_CHUNK OSR registers), so a health check can run in
+     * the frame loop without a hitch. The display keeps running meanwhile.
+     *
+     * @param map Cleared now, filled as the scan progresses; must stay valid
+     *            until pollFaultScan() returns true.
+     */
+    void beginFaultScan(AwFaultMap &map);
+
+    /**
+     * @brief Advance the scan started by beginFaultScan(). Never blocks.
+     *
+     * @return true once the scan is complete (GCR restored, map final);
+     *         also true when no scan is running.
+     */
+    bool pollFaultScan();
+
+    /**
+     * @brief Reload the driver's register copies from the chip.
+     *
+     * The driver mirrors the Page 0 function registers and Page 3 in RAM so
+     * read-modify-write paths never read over SPI. This re-reads both pages
+     * (dropping uncommitted pattern changes) and makes the next show()
+     * resend the whole frame. Use it if another master touched the chip.
+     */
+    void resyncFromChip();
+
+protected:
+    /**
+     * @brief Bind the driver to its storage (see AW20216S, AW20216ST).
+     * @param rows    Number of rows (SWy lines), 1 - maxRows.
+     * @param cols    Number of columns (RGB triplets), 1-6.
+     * @param csPin   MCU GPIO used as Chip Select (active LOW).
+     * @param spiPort SPI bus instance driving the chip.
+     * @param storage AW_DRIVER_RAM(maxRows) bytes, owned by the derived class.
+     * @param maxRows Rows the storage is sized for, 1-12.
+     * @param frame   nullptr, or a scratch frame of AW_BASE_Y(maxRows) bytes
+     *                used as both PWM frames: storage is then
+     *                AW_DRIVER_RAM_INDEXED(maxRows) bytes (no scaling
+     *                buffer) and the driver must stay in indexed mode (see
+     *                AW20216SIndexed).
+     */
+    AW20216SBase(uint8_t rows, uint8_t cols, uint8_t csPin, SPIClass &spiPort,
+                 uint8_t *storage, uint8_t maxRows, uint8_t *frame = nullptr);
+
+    /**
+     * @brief Write the RGB triplet at framebuffer index base (no bounds check).
+     */
+    inline void _setPixelAt(uint8_t base, uint8_t r, uint8_t g, uint8_t b)
+    {
+        uint8_t *p = &_frameBuffer[base];
+
+        *p++ = r;
+        *p++ = g;
+        *p = b;
+
+        _markDirty(base, (uint8_t)(base + 2u));
+    }
+
+#if AW_ENABLE_SCALING_BUFFER
+    /**
+     * @brief Write the scaling triplet at index base (no bounds check).
+     */
+    inline void _setScalingAt(uint8_t base, uint8_t r_scale, uint8_t g_scale, uint8_t b_scale)
+    {
+        uint8_t *p = &_scaling[base];
+
+        *p++ = r_scale;
+        *p++ = g_scale;
+        *p = b_scale;
+    }
+
+    /**
+     * @brief Store a 16-bit RGB triplet as PWM + scaling at index base
+     *        (no bounds check).
+     */
+    void _setPixel16At(uint8_t base, uint16_t r, uint16_t g, uint16_t b);
+#endif
+
+    /**
+     * @brief Bind channel led (framebuffer index, 0-215) to a pattern.
+     */
+    void _setChannelPatternAt(uint8_t led, AwPattern pat);
+
+    /**
+     * @brief Bind the triplet at framebuffer index base to three patterns.
+     */
+    inline void _setPixelPatternAt(uint8_t base, AwPattern rPat, AwPattern gPat, AwPattern bPat)
+    {
+        // The three channels of a pixel share one Page 3 register.
+        writeRegister(AW20216S_PAGE3, (uint8_t)(AW_REG_PATG_BASE + base / 3u),
+                      _packPatterns(rPat, gPat, bPat));
+    }
+
+private:
+    friend class AW20216SArrayBase; // Fills _frameBuffer, batches flushes
+    friend class AW20216SStream;    // Decodes pixels into _frameBuffer
+    friend class AW20216SFlushTask; // Loads queued frames into _frameBuffer
+    friend class AW20216SGroup;     // Drives every CS line for broadcasts
+
+    uint8_t _csPin;       // MCU GPIO used as Chip Select (active LOW)
+    AwFastPin _cs;        // _csPin through its port registers
+    SPIClass *_spiPort;   // SPI bus instance driving the chip
+    AwTransport *_transport; // Replaces _spiPort / _cs when set
+    uint8_t _rows;        // Number of rows (SWy lines) scanned, 1 - _maxRows
+    uint8_t _cols;        // Number of columns (RGB triplets), 1-6
+    uint8_t _maxRows;     // Rows the storage block was sized for
+    uint8_t _frameSize;   // Bytes per frame: 18 * _maxRows (216 at most)
+
+    // Two frames of _maxRows rows * 18 channels (6 R + 6 G + 6 B): one is
+    // drawn into, the other mirrors Page 1 as last sent to the chip.
+    // showAsync() swaps the roles instead of copying.
+    uint8_t *_frameBuffer; // Drawing buffer (setPixel/fillScreen/...)
+    uint8_t *_chipShadow;  // Page 1 as last sent, diffed against by show()
+    bool _shadowValid; // false until the chip content is known (begin/show)
+    bool _asyncBusy;   // A showAsync() burst holds the bus (CS still LOW)
+    uint8_t _dirtyLo;  // First framebuffer index touched since last show()
+    uint8_t _dirtyHi;  // Last framebuffer index touched (lo > hi: clean)
+    const uint8_t *_outputLut; // PROGMEM R/G/B correction tables, or nullptr
+    uint8_t *_viewport;        // Viewport ring (rows x _viewCols RGB), or nullptr
+    uint16_t _viewCols;        // Ring width in pixels
+    uint16_t _viewX;           // Ring column at the panel's left edge
+    uint8_t *_indexed;         // Indexed frame (rows x 6 pixels), or nullptr
+    uint8_t *_palette;         // RGB triplets for the indexed frame
+    uint16_t _paletteSize;     // Entries in _palette
+    uint8_t _indexBpp;         // Bits per indexed pixel, 4 or 8
+
+#if AW_ENABLE_SCALING_BUFFER
+    // Per-LED scaling (Page 2 layout), pushed by showWithScaling().
+    // nullptr on indexed-only storage.
+    uint8_t *_scaling;
+#endif
+
+    // Write-through copy of the Page 0 function registers. A register is only
+    // trusted once its bit in _page0Known is set (written, read, or seeded
+    // with its power-on value by reset()); status/trigger registers are
+    // never cached.
+    uint8_t _page0[AW_PAGE0_REGS];
+    uint8_t _page0Known[(AW_PAGE0_REGS + 7u) / 8u];
+
+    // RAM copy of Page 3 (pattern choice), one register per RGB triplet.
+    uint8_t *_patterns;
+    uint8_t _patDirtyLo; // First Page 3 register changed since commitPatterns()
+    uint8_t _patDirtyHi; // Last changed register (lo > hi: clean)
+
+    // Incremental open/short scan state (see beginFaultScan()).
+    AwFaultMap *_faultMap; // Map being filled, or nullptr when idle
+    uint8_t _faultMode;    // GCR OSDE bits of the running pass
+    uint8_t _faultReg;     // Next OSR register to read in this pass
+    uint32_t _faultT0;     // micros() when the pass was enabled
+
+#if AW_NEEDS_SPI_SCRATCH
+    uint8_t *_spiScratch; // One-frame copy buffer so the full-duplex bulk
+                          // transfer never clobbers _frameBuffer
+#endif
+
+#if AW_ENABLE_STATS
+    AwDriverStats _stats;
+    uint32_t _txStartUs; // micros() at the open beginTransaction()
+#endif
+
+    /**
+     * @brief Burst-write a contiguous block of bytes to one page in a single
+     *        SPI transaction.
+     * @param page     Target page (0-4).
+     * @param startReg First register address; the chip auto-increments.
+     * @param data     Source bytes to send.
+     * @param len      Number of bytes to send.
+     */
+    void _writePageBurst(uint8_t page, uint8_t startReg, const uint8_t *data, uint16_t len);
+
+    /**
+     * @brief Send one CS-framed burst write. The caller must already hold
+     *        the SPI transaction (beginTransaction/endTransaction).
+     * @param page     Target page (0-4).
+     * @param startReg First register address.
+     * @param data     Source bytes to send.
+     * @param len      Number of bytes to send (at most AW_MAX_LEDS).
+     */
+    void _writeFrame(uint8_t page, uint8_t startReg, const uint8_t *data, uint16_t len);
+
+    /**
+     * @brief Like _writeFrame() on Page 1, with the output table applied
+     *        to each byte as it is sent.
+     * @param startReg First PWM register (its %3 gives the first channel).
+     * @param data     Linear framebuffer bytes.
+     * @param len      Number of bytes to send (at most AW_MAX_LEDS).
+     */
+    void _writePwmFrame(uint8_t startReg, const uint8_t *data, uint16_t len);
+
+    /**
+     * @brief Send the viewport window as one CS-framed Page 1 burst.
+     */
+    void _writeViewportFrame();
+
+    /**
+     * @brief Stream the indexed frame, expanded through the palette, to
+     *        Page 1 in one CS frame (caller holds the transaction).
+     */
+    void _writeIndexedFrame();
+
+    /**
+     * @brief true if the driver has no RGB framebuffer of its own (both
+     *        PWM frames share one scratch frame).
+     */
+    inline bool _frameless() const
+    {
+        return _frameBuffer == _chipShadow;
+    }
+
+    /**
+     * @brief Clock out bytes inside an open CS frame (source untouched).
+     */
+    void _sendBytes(const uint8_t *data, uint16_t len);
+
+    /**
+     * @brief Clock out PWM bytes inside an open CS frame, translated by the
+     *        output table if one is set.
+     * @param reg PWM register of the first byte (its %3 gives the channel).
+     */
+    void _sendPwm(uint8_t reg, const uint8_t *data, uint16_t len);
+
+    /**
+     * @brief Output value of PWM register reg holding linear value v.
+     */
+    inline uint8_t _outputPwm(uint8_t reg, uint8_t v) const
+    {
+        return _outputLut ? pgm_read_byte(&_outputLut[((uint16_t)(reg % 3u) << 8) | v]) : v;
+    }
+
+    /**
+     * @brief Send the changed framebuffer runs of Page 1 (the body of
+     *        show()), beginning the SPI transaction only if needed.
+     * @param inTransaction true if the caller already holds the bus.
+     * @return true if a transaction is open on return (caller must end it).
+     */
+    bool _flushFrame(bool inTransaction);
+
+    /**
+     * @brief Clock out a buffer inside an open CS frame. The buffer may be
+     *        overwritten with MISO data on full-duplex bulk cores.
+     * @param buf Bytes to send (scratch contents).
+     * @param len Number of bytes to send.
+     */
+    void _transferBulk(uint8_t *buf, uint16_t len);
+
+    /**
+     * @brief Release CS and the SPI transaction held by showAsync().
+     */
+    void _finishAsync();
+
+    /**
+     * @brief Configure CS and start the SPI port (or the transport).
+     */
+    void _beginBus();
+
+    /**
+     * @brief RAM side of reset(): Page 0 defaults, blank shadow, patterns
+     *        pending again.
+     */
+    void _afterReset();
+
+    /**
+     * @brief Take the SPI bus at the chip's settings (and count it).
+     */
+    inline void _beginTransaction()
+    {
+        if (_transport != nullptr)
+            _transport->beginTransaction();
+        else
+            _spiPort->beginTransaction(SPISettings(AW_SPI_SPEED, MSBFIRST, SPI_MODE0));
+#if AW_ENABLE_STATS
+        _stats.transactions++;
+        _txStartUs = micros();
+#endif
+    }
+
+    /**
+     * @brief Release the SPI bus (and add the time it was held).
+     */
+    inline void _endTransaction()
+    {
+        if (_transport != nullptr)
+            _transport->endTransaction();
+        else
+            _spiPort->endTransaction();
+#if AW_ENABLE_STATS
+        _stats.spiMicros += micros() - _txStartUs;
+#endif
+    }
+
+    /**
+     * @brief Open a CS frame (chip select LOW).
+     */
+    inline void _select()
+    {
+        if (_transport != nullptr)
+            _transport->select();
+        else
+            _cs.low();
+    }
+
+    /**
+     * @brief Close the CS frame (chip select HIGH).
+     */
+    inline void _deselect()
+    {
+        if (_transport != nullptr)
+            _transport->deselect();
+        else
+            _cs.high();
+    }
+
+    /**
+     * @brief Shift one byte inside an open CS frame.
+     */
+    inline uint8_t _transfer(uint8_t b)
+    {
+        return (_transport != nullptr) ? _transport->transfer(b) : _spiPort->transfer(b);
+    }
+
+    /**
+     * @brief Count one CS-framed command: written bytes include the
+     *        command and address header, read bytes are the data only.
+     */
+    inline void _noteFrame(uint8_t page, uint16_t written, uint16_t read = 0)
+    {
+#if AW_ENABLE_STATS
+        if (page >= AW_STATS_PAGES)
+            return;
+        _stats.csToggles += 2u;
+        _stats.bytesWritten[page] += written;
+        _stats.bytesRead[page] += read;
+#else
+        (void)page;
+        (void)written;
+        (void)read;
+#endif
+    }
+
+    /**
+     * @brief Zero the whole framebuffer (RAM only, does not touch the chip).
      */
     inline void _clearFrameBuffer()
     {
-        memset(_frameBuffer, 0, AW_MAX_LEDS);
+        memset(_frameBuffer, 0, _frameSize);
+    }
+
+    /**
+     * @brief Page 3 registers backed by the storage (one per RGB triplet).
+     */
+    inline uint8_t _patternRegs() const
+    {
+        return (uint8_t)(_frameSize / 3u);
     }
+
+    /**
+     * @brief Widen the dirty range so show() scans [lo, hi] (inclusive).
+     */
+    inline void _markDirty(uint8_t lo, uint8_t hi)
+    {
+        if (lo < _dirtyLo)
+            _dirtyLo = lo;
+        if (hi > _dirtyHi)
+            _dirtyHi = hi;
+    }
+
+    /**
+     * @brief Clip a w x h rectangle at (x, y) to the panel.
+     *
+     * On return x/y/w/h describe the visible part and srcX/srcY the offset
+     * of that part inside the source rectangle.
+     *
+     * @return false if nothing is visible.
+     */
+    bool _clipRect(int16_t &x, int16_t &y, int16_t &w, int16_t &h,
+                   uint8_t &srcX, uint8_t &srcY) const;
+
+    /**
+     * @brief Shared body of blitRGB() / blitRGB_P().
+     */
+    void _blitRGB(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *rgb, bool progmem);
+
+    /**
+     * @brief Shared body of blit1bpp() / blit1bpp_P().
+     */
+    void _blit1bpp(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bits,
+                   uint8_t r, uint8_t g, uint8_t b, bool progmem);
+
+    /**
+     * @brief Read a Page 0 register from the RAM copy, falling back to SPI
+     *        (and caching the result) the first time.
+     */
+    uint8_t _readPage0(uint8_t reg);
+
+    /**
+     * @brief Record a value written to / read from a Page 0 register.
+     */
+    void _cachePage0(uint8_t reg, uint8_t value);
+
+    /**
+     * @brief Send Page 0 registers [lo, hi] from the RAM copy in one burst.
+     */
+    void _flushPage0(uint8_t lo, uint8_t hi);
+
+    /**
+     * @brief Update the RAM copies after a raw write to page/reg.
+     */
+    void _noteWrite(uint8_t page, uint16_t reg, uint8_t value);
+
+    /**
+     * @brief Switch GCR open/short detection to mode (AW_GCR_OSDE_* or 0).
+     */
+    void _setFaultDetect(uint8_t mode);
+
+    /**
+     * @brief OSR registers that cover the scanned rows.
+     */
+    inline uint8_t _faultRegs() const
+    {
+        return (uint8_t)(_rows * 3u);
+    }
+
+    /**
+     * @brief Set the map bits of n OSR registers starting at OSR first.
+     */
+    void _decodeFaults(uint8_t *bits, uint8_t first, const uint8_t *osr, uint8_t n) const;
+
+    /**
+     * @brief Forget every Page 0 copy, then seed the power-on defaults.
+     */
+    void _seedPage0Defaults();
+
+    /**
+     * @brief true for Page 0 registers that change on their own or act on
+     *        write (open/short status, reset, pattern start): never cached.
+     */
+    static inline bool _isVolatilePage0(uint8_t reg)
+    {
+        return (reg >= AW_REG_OSR_BASE && reg < AW_REG_OTCR) ||
+               reg == AW_REG_RSTN || reg == AW_REG_PATGO;
+    }
+
+    /**
+     * @brief PATxCFG value for an enabled, autonomous engine (other bits kept).
+     */
+    static inline uint8_t _breathingCfg(uint8_t cfg, bool logarithmic)
+    {
+        cfg &= (uint8_t)~(AW_PATCFG_PATEN | AW_PATCFG_LOGEN | AW_PATCFG_PATMD);
+        cfg |= AW_PATCFG_PATEN | AW_PATCFG_PATMD;
+        if (logarithmic)
+            cfg |= AW_PATCFG_LOGEN;
+        return cfg;
+    }
+
+    /**
+     * @brief Pack three channel patterns into one Page 3 register value.
+     */
+    static inline uint8_t _packPatterns(AwPattern rPat, AwPattern gPat, AwPattern bPat)
+    {
+        return (uint8_t)((((uint8_t)rPat & 0x03u) << 0) |
+                         (((uint8_t)gPat & 0x03u) << 2) |
+                         (((uint8_t)bPat & 0x03u) << 4));
+    }
+
+    /**
+     * @brief Store a Page 3 register in RAM and widen the commit range.
+     */
+    inline void _setPatternReg(uint8_t reg, uint8_t value)
+    {
+        if (_patterns[reg] == value)
+            return;
+        _patterns[reg] = value;
+        if (reg < _patDirtyLo)
+            _patDirtyLo = reg;
+        if (reg > _patDirtyHi)
+            _patDirtyHi = reg;
+    }
+
+    /**
+     * @brief Reset the dirty range to "nothing changed".
+     */
+    inline void _markClean()
+    {
+        _dirtyLo = 0xFF;
+        _dirtyHi = 0x00;
+    }
+};
+
+//* AW20216S Class Definition */
+
+class AW20216S : public AW20216SBase
+{
+public:
+    /**
+     * @brief Construct the driver for one AW20216S device.
+     *
+     * Stores the geometry and SPI configuration but does NOT touch the
+     * hardware yet; call begin() before any other method. RAM for all 12
+     * rows is reserved, so setActiveRows() can grow up to 12; see
+     * AW20216ST for a driver sized to the panel at compile time.
+     *
+     * @param rows    Number of rows (SWy lines) wired to the matrix.
+     *                For the LMX2 6x12 RGB panel this is 12. Valid range 1-12.
+     * @param cols    Number of columns (RGB triplets / CSx groups).
+     *                For the LMX2 6x12 RGB panel this is 6. Valid range 1-6.
+     * @param csPin   MCU GPIO used as Chip Select (active LOW).
+     *                Typical values: 10 on Arduino UNO, 5 or 15 on ESP32.
+     * @param spiPort SPI bus instance to drive the chip. Defaults to the
+     *                board's primary `SPI`. Pass e.g. `SPI1` / `HSPI` on MCUs
+     *                that expose several SPI peripherals.
+     */
+    AW20216S(uint8_t rows, uint8_t cols, uint8_t csPin, SPIClass &spiPort = SPI)
+        : AW20216SBase(rows, cols, csPin, spiPort, _storage, AW_MAX_ROWS) {}
+
+private:
+    uint8_t _storage[AW_DRIVER_RAM(AW_MAX_ROWS)];
 };
 
 #endif // AW20216S_H
\ No newline at end of file
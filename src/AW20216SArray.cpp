@@ -0,0 +1,254 @@
+#include "AW20216SArray.h"
+
+//******************************************************** */
+
+/**
+ * @brief Bind the array to its world framebuffer and slot table.
+ *
+ * @param width     World width in pixels.
+ * @param height    World height in pixels.
+ * @param world     width * height * 3 bytes of framebuffer.
+ * @param slots     Slot table with room for maxPanels entries.
+ * @param maxPanels Capacity of the slot table.
+ */
+AW20216SArrayBase::AW20216SArrayBase(uint8_t width, uint8_t height, uint8_t *world,
+                                     AwPanelSlot *slots, uint8_t maxPanels)
+{
+    _width = width;
+    _height = height;
+    _world = world;
+    _slots = slots;
+    _maxPanels = maxPanels;
+    _count = 0;
+    memset(_world, 0, (size_t)_width * _height * 3u);
+    _markClean();
+}
+
+//******************************************************** */
+
+/**
+ * @brief Register a chip and where it sits in the world.
+ *
+ * @param chip     Panel driver (must outlive the array).
+ * @param x        World column of the footprint's left edge.
+ * @param y        World row of the footprint's top edge.
+ * @param rotation Clockwise rotation of the panel as mounted.
+ * @param mirrorX  Panel columns run right-to-left.
+ * @return true if the panel was added.
+ */
+bool AW20216SArrayBase::addPanel(AW20216SBase &chip, uint8_t x, uint8_t y,
+                                 AwRotation rotation, bool mirrorX)
+{
+    if (_count >= _maxPanels)
+        return false;
+
+    const bool sideways = (rotation == AwRotation::R90 || rotation == AwRotation::R270);
+    const uint8_t w = sideways ? chip._rows : chip._cols;
+    const uint8_t h = sideways ? chip._cols : chip._rows;
+
+    if ((uint16_t)x + w > _width || (uint16_t)y + h > _height)
+        return false;
+
+    AwPanelSlot &slot = _slots[_count++];
+    slot.chip = &chip;
+    slot.x = x;
+    slot.y = y;
+    slot.w = w;
+    slot.h = h;
+    slot.rotation = rotation;
+    slot.mirrorX = mirrorX;
+
+    _markDirty(x, y, (uint8_t)(x + w - 1u), (uint8_t)(y + h - 1u));
+    return true;
+}
+
+//******************************************************** */
+
+/**
+ * @brief Initialize every panel.
+ *
+ * @return true if all chips read back GCR as expected.
+ */
+bool AW20216SArrayBase::begin()
+{
+    bool ok = true;
+    for (uint8_t i = 0; i < _count; i++)
+        ok = _slots[i].chip->begin() && ok;
+    return ok;
+}
+
+//******************************************************** */
+
+/**
+ * @brief Set one world pixel. Call showAll() to apply.
+ *
+ * @param x World column.
+ * @param y World row.
+ * @param r Red   PWM value, 0-255.
+ * @param g Green PWM value, 0-255.
+ * @param b Blue  PWM value, 0-255.
+ */
+void AW20216SArrayBase::setPixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b)
+{
+    if (x >= _width || y >= _height)
+        return;
+
+    uint8_t *px = &_world[((uint16_t)y * _width + x) * 3u];
+    px[0] = r;
+    px[1] = g;
+    px[2] = b;
+    _markDirty(x, y, x, y);
+}
+
+/**
+ * @brief Fill the world with one color. Call showAll() to apply.
+ *
+ * @param r Red   PWM value, 0-255.
+ * @param g Green PWM value, 0-255.
+ * @param b Blue  PWM value, 0-255.
+ */
+void AW20216SArrayBase::fillScreen(uint8_t r, uint8_t g, uint8_t b)
+{
+    const uint16_t n = (uint16_t)_width * _height * 3u;
+    for (uint16_t i = 0; i < n; i += 3)
+    {
+        _world[i + 0] = r;
+        _world[i + 1] = g;
+        _world[i + 2] = b;
+    }
+    _markDirty(0, 0, (uint8_t)(_width - 1u), (uint8_t)(_height - 1u));
+}
+
+/**
+ * @brief Clear the world (all pixels off). Call showAll() to apply.
+ */
+void AW20216SArrayBase::clearScreen()
+{
+    memset(_world, 0, (size_t)_width * _height * 3u);
+    _markDirty(0, 0, (uint8_t)(_width - 1u), (uint8_t)(_height - 1u));
+}
+
+//******************************************************** */
+
+/**
+ * @brief Remap the changed panels and flush every chip in one transaction.
+ */
+void AW20216SArrayBase::showAll()
+{
+    // A showAsync() on any chip holds the bus with CS low: drain them first.
+    for (uint8_t i = 0; i < _count; i++)
+        _slots[i].chip->waitShow();
+
+    AW20216SBase *openChip = nullptr; // Chip whose transaction is held
+
+    for (uint8_t i = 0; i < _count; i++)
+    {
+        const AwPanelSlot &slot = _slots[i];
+        AW20216SBase &chip = *slot.chip;
+
+        if (slot.x <= _dirtyX1 && (uint8_t)(slot.x + slot.w - 1u) >= _dirtyX0 &&
+            slot.y <= _dirtyY1 && (uint8_t)(slot.y + slot.h - 1u) >= _dirtyY0)
+            _mapPanel(slot);
+
+        if (openChip != nullptr &&
+            (openChip->_spiPort != chip._spiPort || openChip->_transport != chip._transport))
+        {
+            openChip->_endTransaction();
+            openChip = nullptr;
+        }
+
+        if (chip._flushFrame(openChip != nullptr) && openChip == nullptr)
+            openChip = &chip;
+    }
+
+    if (openChip != nullptr)
+        openChip->_endTransaction();
+
+    _markClean();
+}
+
+/**
+ * @brief Force a full resend of every panel on the next showAll().
+ */
+void AW20216SArrayBase::invalidate()
+{
+    for (uint8_t i = 0; i < _count; i++)
+        _slots[i].chip->invalidate();
+    _markDirty(0, 0, (uint8_t)(_width - 1u), (uint8_t)(_height - 1u));
+}
+
+//******************************************************** */
+
+/**
+ * @brief Copy a panel's world region into its chip framebuffer.
+ *
+ * @param slot Panel placement.
+ */
+void AW20216SArrayBase::_mapPanel(const AwPanelSlot &slot)
+{
+    AW20216SBase &chip = *slot.chip;
+    const bool sideways = (slot.rotation == AwRotation::R90 || slot.rotation == AwRotation::R270);
+    const uint8_t cols = sideways ? slot.h : slot.w;
+    const uint8_t rows = sideways ? slot.w : slot.h;
+
+    // The mapping is affine: walk it with two strides instead of
+    // re-evaluating the rotation for every pixel.
+    const int32_t origin = _worldIndex(slot, 0, 0);
+    const int32_t stepX = (cols > 1) ? _worldIndex(slot, 1, 0) - origin : 0;
+    const int32_t stepY = (rows > 1) ? _worldIndex(slot, 0, 1) - origin : 0;
+
+    for (uint8_t ly = 0; ly < rows; ly++)
+    {
+        int32_t src = origin + stepY * ly;
+        uint8_t *dst = &chip._frameBuffer[AW_BASE_Y(ly)];
+        for (uint8_t lx = 0; lx < cols; lx++, src += stepX, dst += 3)
+        {
+            dst[0] = _world[src + 0];
+            dst[1] = _world[src + 1];
+            dst[2] = _world[src + 2];
+        }
+    }
+
+    chip._markDirty(0, (uint8_t)(AW_BASE_Y(rows) - 1u));
+}
+
+/**
+ * @brief World byte offset of a panel-local pixel.
+ *
+ * @param slot Panel placement.
+ * @param lx   Panel column.
+ * @param ly   Panel row.
+ * @return Offset of the pixel's R byte in the world framebuffer.
+ */
+int32_t AW20216SArrayBase::_worldIndex(const AwPanelSlot &slot, uint8_t lx, uint8_t ly) const
+{
+    const bool sideways = (slot.rotation == AwRotation::R90 || slot.rotation == AwRotation::R270);
+    const uint8_t cols = sideways ? slot.h : slot.w;
+    const uint8_t rows = sideways ? slot.w : slot.h;
+
+    if (slot.mirrorX)
+        lx = (uint8_t)(cols - 1u - lx);
+
+    uint8_t fx, fy; // Position inside the footprint
+    switch (slot.rotation)
+    {
+    case AwRotation::R90:
+        fx = (uint8_t)(rows - 1u - ly);
+        fy = lx;
+        break;
+    case AwRotation::R180:
+        fx = (uint8_t)(cols - 1u - lx);
+        fy = (uint8_t)(rows - 1u - ly);
+        break;
+    case AwRotation::R270:
+        fx = ly;
+        fy = (uint8_t)(cols - 1u - lx);
+        break;
+    default:
+        fx = lx;
+        fy = ly;
+        break;
+    }
+
+    return ((int32_t)(slot.y + fy) * _width + (slot.x + fx)) * 3;
+}
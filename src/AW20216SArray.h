@@ -0,0 +1,196 @@
+#ifndef AW20216S_ARRAY_H
+#define AW20216S_ARRAY_H
+
+#include "AW20216S.h"
+
+/**
+ * Several AW20216S chips drawn as one canvas.
+ *
+ * The array owns a contiguous RGB "world" framebuffer (row-major, 3 bytes per
+ * pixel). Each chip covers a rectangle of it, mounted with a rotation and an
+ * optional mirror. showAll() copies the changed regions into the chips and
+ * flushes them back-to-back inside one SPI transaction.
+ */
+
+// Placement of one chip inside the world framebuffer.
+struct AwPanelSlot
+{
+    AW20216SBase *chip;  // Driver of the panel (AW20216S or AW20216ST)
+    uint8_t x, y;        // World coordinates of the footprint's top-left
+    uint8_t w, h;        // Footprint size in world pixels (rotation applied)
+    AwRotation rotation; // Clockwise rotation of the panel as mounted
+    bool mirrorX;        // Panel columns mirrored (applied before rotation)
+};
+
+//* AW20216SArrayBase Class Definition */
+
+class AW20216SArrayBase
+{
+public:
+    // Panels are referenced through the slot table: not copyable.
+    AW20216SArrayBase(const AW20216SArrayBase &) = delete;
+    AW20216SArrayBase &operator=(const AW20216SArrayBase &) = delete;
+
+    /**
+     * @brief Place a chip in the world.
+     *
+     * The footprint is cols x rows of the chip (rows x cols for R90/R270)
+     * and must lie inside the world. Panels should not overlap.
+     *
+     * @param chip     Driver of the panel. Must outlive the array.
+     * @param x        World column of the footprint's left edge.
+     * @param y        World row of the footprint's top edge.
+     * @param rotation Clockwise rotation of the panel as mounted.
+     * @param mirrorX  true if the panel columns run right-to-left (applied
+     *                 before the rotation).
+     * @return false if the slot table is full or the footprint does not fit.
+     */
+    bool addPanel(AW20216SBase &chip, uint8_t x, uint8_t y,
+                  AwRotation rotation = AwRotation::R0, bool mirrorX = false);
+
+    /**
+     * @brief Call begin() on every panel.
+     * @return true if every chip answered.
+     */
+    bool begin();
+
+    /**
+     * @brief Write one RGB pixel of the world framebuffer.
+     *
+     * Out-of-range coordinates are ignored (no-op).
+     *
+     * @param x World column, 0 - (width-1).
+     * @param y World row,    0 - (height-1).
+     * @param r Red   PWM value, 0-255.
+     * @param g Green PWM value, 0-255.
+     * @param b Blue  PWM value, 0-255.
+     * @note RAM-only operation. Call showAll() to push it to the chips.
+     */
+    void setPixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b);
+
+    /**
+     * @brief Fill the whole world with one RGB color.
+     * @note RAM-only operation. Call showAll() to push it to the chips.
+     */
+    void fillScreen(uint8_t r, uint8_t g, uint8_t b);
+
+    /**
+     * @brief Clear the whole world (all pixels off).
+     * @note RAM-only operation. Call showAll() to push it to the chips.
+     */
+    void clearScreen();
+
+    /**
+     * @brief Push the world to every panel in one SPI bus acquisition.
+     *
+     * Only panels whose region changed since the last showAll() are
+     * remapped; each chip then sends just its changed PWM runs (the same
+     * delta rule as show()). Chips on different SPI ports get one
+     * transaction per port run.
+     */
+    void showAll();
+
+    /**
+     * @brief Make the next showAll() resend every panel in full.
+     */
+    void invalidate();
+
+    /** @brief World width in pixels. */
+    inline uint8_t width() const { return _width; }
+
+    /** @brief World height in pixels. */
+    inline uint8_t height() const { return _height; }
+
+    /** @brief Number of panels added so far. */
+    inline uint8_t panelCount() const { return _count; }
+
+    /**
+     * @brief Driver of panel i (in addPanel() order), e.g. to set its
+     *        global current or breathing engines.
+     */
+    inline AW20216SBase &panel(uint8_t i) { return *_slots[i].chip; }
+
+protected:
+    /**
+     * @brief Bind the array to its storage (see AW20216SArray).
+     * @param width     World width in pixels.
+     * @param height    World height in pixels.
+     * @param world     width * height * 3 bytes of framebuffer.
+     * @param slots     Slot table with room for maxPanels entries.
+     * @param maxPanels Capacity of the slot table.
+     */
+    AW20216SArrayBase(uint8_t width, uint8_t height, uint8_t *world,
+                      AwPanelSlot *slots, uint8_t maxPanels);
+
+private:
+    uint8_t _width;        // World width in pixels
+    uint8_t _height;       // World height in pixels
+    uint8_t *_world;       // Row-major RGB world framebuffer
+    AwPanelSlot *_slots;   // Panel placements
+    uint8_t _maxPanels;    // Capacity of _slots
+    uint8_t _count;        // Panels added
+
+    // World rectangle touched since the last showAll() (x0 > x1: clean).
+    uint8_t _dirtyX0, _dirtyY0, _dirtyX1, _dirtyY1;
+
+    /**
+     * @brief Copy a panel's region of the world into its chip framebuffer.
+     */
+    void _mapPanel(const AwPanelSlot &slot);
+
+    /**
+     * @brief Byte offset in the world of panel-local pixel (lx, ly).
+     */
+    int32_t _worldIndex(const AwPanelSlot &slot, uint8_t lx, uint8_t ly) const;
+
+    /**
+     * @brief Widen the dirty rectangle to include [x0, x1] x [y0, y1].
+     */
+    inline void _markDirty(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+    {
+        if (x0 < _dirtyX0)
+            _dirtyX0 = x0;
+        if (y0 < _dirtyY0)
+            _dirtyY0 = y0;
+        if (x1 > _dirtyX1)
+            _dirtyX1 = x1;
+        if (y1 > _dirtyY1)
+            _dirtyY1 = y1;
+    }
+
+    inline void _markClean()
+    {
+        _dirtyX0 = _dirtyY0 = 0xFF;
+        _dirtyX1 = _dirtyY1 = 0x00;
+    }
+};
+
+/**
+ * @brief Panel array with statically sized storage.
+ *
+ * @tparam Width     World width in pixels.
+ * @tparam Height    World height in pixels.
+ * @tparam MaxPanels Number of chips that can be added.
+ *
+ * @code
+ * AW20216S left(12, 6, 5), right(12, 6, 15);
+ * AW20216SArray<12, 12, 2> wall;
+ * wall.addPanel(left, 0, 0);
+ * wall.addPanel(right, 6, 0);
+ * @endcode
+ */
+template <uint8_t Width, uint8_t Height, uint8_t MaxPanels>
+class AW20216SArray : public AW20216SArrayBase
+{
+    static_assert(Width > 0 && Height > 0 && MaxPanels > 0, "empty AW20216SArray");
+    static_assert((uint32_t)Width * Height * 3u <= 0xFFFFu, "world framebuffer too large");
+
+public:
+    AW20216SArray() : AW20216SArrayBase(Width, Height, _worldStorage, _slotStorage, MaxPanels) {}
+
+private:
+    uint8_t _worldStorage[(uint16_t)Width * Height * 3u];
+    AwPanelSlot _slotStorage[MaxPanels];
+};
+
+#endif // AW20216S_ARRAY_H
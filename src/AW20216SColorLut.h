@@ -0,0 +1,146 @@
+#ifndef AW20216S_COLOR_LUT_H
+#define AW20216S_COLOR_LUT_H
+
+#include <Arduino.h>
+
+/**
+ * Output color correction tables, generated at compile time.
+ *
+ * A table holds 3 x 256 bytes (R, then G, then B) in PROGMEM and maps a
+ * linear framebuffer value to the PWM byte sent to the chip:
+ *
+ *   out = round(255 * (v / 255)^gamma * white[ch] / 255 * cap / 255)
+ *
+ * Pass AwColorLut<...>::table to AW20216S::setOutputLut(). Only the tables
+ * a sketch names end up in flash.
+ */
+
+namespace aw_lut_detail
+{
+// C++11 constexpr functions are a single return statement, so ln/exp are
+// written as recursions with range reduction.
+
+constexpr double kLn2 = 0.6931471805599453;
+
+// ln(x) = 2 * atanh(z), z = (x - 1) / (x + 1), summed as z^(2k+1) / (2k+1)
+constexpr double lnSeries(double z2, double term, int k)
+{
+    return k > 24 ? 0.0 : term / (2 * k + 1) + lnSeries(z2, term * z2, k + 1);
+}
+
+constexpr double lnReduced(double z)
+{
+    return 2.0 * lnSeries(z * z, z, 0);
+}
+
+// x > 0; brought into [0.5, 1] where the series converges fast.
+constexpr double ln(double x)
+{
+    return x < 0.5 ? ln(x * 2.0) - kLn2
+         : x > 1.0 ? ln(x * 0.5) + kLn2
+                   : lnReduced((x - 1.0) / (x + 1.0));
+}
+
+// Taylor series, term = y^k / k!
+constexpr double expSeries(double y, double term, int k)
+{
+    return k > 16 ? 0.0 : term + expSeries(y, term * y / (k + 1), k + 1);
+}
+
+constexpr double square(double x)
+{
+    return x * x;
+}
+
+// exp(y) = exp(y / 2)^2 until |y| <= 0.5.
+constexpr double exp(double y)
+{
+    return (y < -0.5 || y > 0.5) ? square(exp(y * 0.5)) : expSeries(y, 1.0, 0);
+}
+
+constexpr uint8_t entry(uint16_t gammaX100, uint8_t white, uint8_t cap, uint8_t v)
+{
+    return v == 0 ? 0
+                  : (uint8_t)(exp(gammaX100 / 100.0 * ln(v / 255.0)) * white * cap / 255.0 + 0.5);
+}
+
+// The tables live in flash, so they must be constant-initialized: these
+// fail to compile if the math above is not evaluated at compile time.
+static_assert(entry(220, 255, 255, 255) == 255, "AwColorLut: full scale");
+static_assert(entry(220, 255, 255, 128) == 56, "AwColorLut: gamma 2.2 midpoint");
+
+// Compile-time index list 0..N-1, built in log depth so 768 entries stay
+// far from the template recursion limit.
+template <uint16_t... I>
+struct Seq
+{
+};
+
+template <class A, class B>
+struct SeqCat;
+
+template <uint16_t... A, uint16_t... B>
+struct SeqCat<Seq<A...>, Seq<B...>>
+{
+    typedef Seq<A..., (uint16_t)(sizeof...(A) + B)...> type;
+};
+
+template <uint16_t N>
+struct MakeSeq
+{
+    typedef typename SeqCat<typename MakeSeq<N / 2>::type,
+                            typename MakeSeq<N - N / 2>::type>::type type;
+};
+
+template <>
+struct MakeSeq<0>
+{
+    typedef Seq<> type;
+};
+
+template <>
+struct MakeSeq<1>
+{
+    typedef Seq<0> type;
+};
+
+template <uint16_t GammaX100, uint8_t WhiteR, uint8_t WhiteG, uint8_t WhiteB, uint8_t Cap, class S>
+struct Table;
+
+template <uint16_t GammaX100, uint8_t WhiteR, uint8_t WhiteG, uint8_t WhiteB, uint8_t Cap, uint16_t... I>
+struct Table<GammaX100, WhiteR, WhiteG, WhiteB, Cap, Seq<I...>>
+{
+    static const uint8_t table[sizeof...(I)];
+};
+
+template <uint16_t GammaX100, uint8_t WhiteR, uint8_t WhiteG, uint8_t WhiteB, uint8_t Cap, uint16_t... I>
+const uint8_t Table<GammaX100, WhiteR, WhiteG, WhiteB, Cap, Seq<I...>>::table[sizeof...(I)] PROGMEM = {
+    entry(GammaX100,
+          (I >> 8) == 0 ? WhiteR : (I >> 8) == 1 ? WhiteG : WhiteB,
+          Cap,
+          (uint8_t)(I & 0xFFu))...};
+} // namespace aw_lut_detail
+
+/**
+ * @brief Per-channel output table: gamma, white point and brightness cap.
+ *
+ * @tparam GammaX100 Gamma times 100 (220 = 2.2, 100 = linear).
+ * @tparam WhiteR    Red   gain at full input, 0-255 (white point).
+ * @tparam WhiteG    Green gain at full input, 0-255.
+ * @tparam WhiteB    Blue  gain at full input, 0-255.
+ * @tparam Cap       Global brightness cap, 0-255.
+ *
+ * @code
+ * ledMatrix.setOutputLut(AwColorLut<>::table);                  // gamma 2.2
+ * ledMatrix.setOutputLut(AwColorLut<250, 255, 200, 170>::table); // warmer
+ * @endcode
+ */
+template <uint16_t GammaX100 = 220, uint8_t WhiteR = 255, uint8_t WhiteG = 255,
+          uint8_t WhiteB = 255, uint8_t Cap = 255>
+struct AwColorLut
+    : aw_lut_detail::Table<GammaX100, WhiteR, WhiteG, WhiteB, Cap,
+                           aw_lut_detail::MakeSeq<768>::type>
+{
+};
+
+#endif // AW20216S_COLOR_LUT_H
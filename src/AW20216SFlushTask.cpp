@@ -0,0 +1,220 @@
+#include "AW20216SFlushTask.h"
+
+//******************************************************** */
+
+/**
+ * @brief Bind the queue to its drivers and storage; the queue starts empty.
+ *
+ * @param chips Drivers, flushed in array order.
+ * @param count Number of drivers.
+ * @param slots Slot storage.
+ * @param size  Bytes at slots.
+ * @param depth Requested slots (rounded down to a power of two that fits).
+ */
+AW20216SFlushTask::AW20216SFlushTask(AW20216SBase *const *chips, uint8_t count, uint8_t *slots,
+                                     uint16_t size, uint8_t depth)
+{
+    _chips = chips;
+    _count = count;
+    _slots = slots;
+
+    _frameBytes = 0;
+    for (uint8_t i = 0; i < count; i++)
+        _frameBytes = (uint16_t)(_frameBytes + AW_BASE_Y(chips[i]->_rows));
+
+    // Largest power of two <= depth whose slots fit in size.
+    uint8_t d = 128;
+    while (d > depth || (uint32_t)d * _frameBytes > size)
+    {
+        d >>= 1;
+        if (d == 0)
+            break;
+    }
+    if (d == 0)
+    {
+        // Not even one frame fits: keep a valid, always-full queue.
+        _count = 0;
+        _frameBytes = 0;
+        d = 1;
+    }
+    _depth = d;
+
+    _head = 0;
+    _tail = 0;
+    _acquired = false;
+    _maxQueued = 0;
+    _dropped = 0;
+    _shown = 0;
+#if AW_HAS_FREERTOS
+    _task = nullptr;
+    _stopping = false;
+#endif
+}
+
+/**
+ * @brief Byte offset of a chip's framebuffer in a frame.
+ *
+ * @param chip Index in the chips array.
+ * @return Offset, or frameBytes() for an out-of-range chip.
+ */
+uint16_t AW20216SFlushTask::chipOffset(uint8_t chip) const
+{
+    uint16_t at = 0;
+    for (uint8_t i = 0; i < chip && i < _count; i++)
+        at = (uint16_t)(at + AW_BASE_Y(_chips[i]->_rows));
+    return at;
+}
+
+//******************************************************** */
+
+/**
+ * @brief Reserve the slot at the head if the consumer has freed it.
+ *
+ * @return Slot to render into, or nullptr when the queue is full.
+ */
+uint8_t *AW20216SFlushTask::acquireFrame()
+{
+    if (_count == 0 || (uint8_t)(_head - _loadTail()) >= _depth)
+    {
+        _dropped++;
+        return nullptr;
+    }
+    _acquired = true;
+    return _slot(_head);
+}
+
+/**
+ * @brief Hand the acquired slot to the consumer and wake the flush task.
+ */
+void AW20216SFlushTask::commitFrame()
+{
+    if (!_acquired)
+        return;
+    _acquired = false;
+
+    // Release: the slot's bytes are visible before the new head.
+    const uint8_t head = (uint8_t)(_head + 1u);
+    __atomic_store_n(&_head, head, __ATOMIC_RELEASE);
+
+    const uint8_t depth = (uint8_t)(head - _loadTail());
+    if (depth > _maxQueued)
+        _maxQueued = depth;
+
+#if AW_HAS_FREERTOS
+    TaskHandle_t task = _task;
+    if (task != nullptr)
+        xTaskNotifyGive(task);
+#endif
+}
+
+/**
+ * @brief Copy a frame into the next free slot and publish it.
+ *
+ * @param frame frameBytes() bytes.
+ * @return false if the queue was full.
+ */
+bool AW20216SFlushTask::submitFrame(const uint8_t *frame)
+{
+    uint8_t *slot = acquireFrame();
+    if (slot == nullptr)
+        return false;
+    memcpy(slot, frame, _frameBytes);
+    commitFrame();
+    return true;
+}
+
+//******************************************************** */
+
+/**
+ * @brief Load the oldest slot into the drivers and show it.
+ *
+ * show() sends only the bytes that differ from the chip, as for a frame
+ * drawn in place; the slot is released once every chip has it.
+ *
+ * @return false if nothing was queued.
+ */
+bool AW20216SFlushTask::service()
+{
+    const uint8_t tail = _tail;
+    if (_loadHead() == tail)
+        return false;
+
+    const uint8_t *src = _slot(tail);
+    for (uint8_t i = 0; i < _count; i++)
+    {
+        AW20216SBase *chip = _chips[i];
+        const uint8_t n = (uint8_t)AW_BASE_Y(chip->_rows);
+
+        memcpy(chip->_frameBuffer, src, n);
+        chip->_markDirty(0, (uint8_t)(n - 1u));
+        chip->show();
+        src += n;
+    }
+
+    // Release: the producer may reuse the slot only after it was read.
+    __atomic_store_n(&_tail, (uint8_t)(tail + 1u), __ATOMIC_RELEASE);
+    _shown++;
+    return true;
+}
+
+#if AW_HAS_FREERTOS
+/**
+ * @brief Create the flush task pinned to a core.
+ *
+ * @param core     Core id, or tskNO_AFFINITY.
+ * @param priority Task priority.
+ * @param stack    Stack size in bytes.
+ * @return true if the task was created.
+ */
+bool AW20216SFlushTask::start(BaseType_t core, UBaseType_t priority, uint32_t stack)
+{
+    if (_task != nullptr)
+        return false;
+
+    _stopping = false;
+    TaskHandle_t task = nullptr;
+    if (xTaskCreatePinnedToCore(_taskMain, "aw_flush", stack, this, priority, &task, core) != pdPASS)
+        return false;
+    _task = task;
+
+    // Frames submitted before start() were not signalled.
+    xTaskNotifyGive(task);
+    return true;
+}
+
+/**
+ * @brief Ask the task to exit and wait until it has.
+ */
+void AW20216SFlushTask::stop()
+{
+    TaskHandle_t task = _task;
+    if (task == nullptr)
+        return;
+
+    _stopping = true;
+    xTaskNotifyGive(task);
+    while (_task != nullptr)
+        vTaskDelay(1);
+}
+
+/**
+ * @brief Flush everything queued, then block until the producer notifies.
+ *
+ * @param self The AW20216SFlushTask.
+ */
+void AW20216SFlushTask::_taskMain(void *self)
+{
+    AW20216SFlushTask *q = static_cast<AW20216SFlushTask *>(self);
+
+    while (!q->_stopping)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (!q->_stopping && q->service())
+        {
+        }
+    }
+
+    q->_task = nullptr;
+    vTaskDelete(nullptr);
+}
+#endif
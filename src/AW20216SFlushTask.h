@@ -0,0 +1,230 @@
+#ifndef AW20216S_FLUSH_TASK_H
+#define AW20216S_FLUSH_TASK_H
+
+#include "AW20216S.h"
+
+/**
+ * Render / flush pipeline across two cores.
+ *
+ * AW20216SFlushTask takes finished frames from the renderer through a
+ * lock-free single-producer / single-consumer queue of frame slots and
+ * pushes them to one or more drivers with show(). On ESP32 the consumer is
+ * a FreeRTOS task pinned to a chosen core, so the SPI traffic no longer
+ * stalls loop(), Wi-Fi or the renderer. Elsewhere (or with
+ * AW_HAS_FREERTOS=0) call service() from whatever context owns the bus.
+ *
+ * While the pipeline runs the drivers belong to the flush side: the
+ * renderer writes frames into queue slots (raw framebuffer bytes, or
+ * captureFrame() of a canvas driver that is never begin()'d) and must not
+ * call show() or drawing functions on the flushed drivers itself.
+ */
+
+// FreeRTOS flush task (start() / stop()). ESP32 cores always have it.
+#ifndef AW_HAS_FREERTOS
+#if defined(ARDUINO_ARCH_ESP32)
+#define AW_HAS_FREERTOS 1
+#else
+#define AW_HAS_FREERTOS 0
+#endif
+#endif
+
+#if AW_HAS_FREERTOS
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+// Flush task defaults. Arduino-ESP32 runs loop() on core 1, so the flush
+// goes to core 0 at a priority just above loopTask.
+#ifndef AW_FLUSH_TASK_CORE
+#define AW_FLUSH_TASK_CORE 0
+#endif
+#ifndef AW_FLUSH_TASK_PRIORITY
+#define AW_FLUSH_TASK_PRIORITY 2
+#endif
+#ifndef AW_FLUSH_TASK_STACK
+#define AW_FLUSH_TASK_STACK 3072
+#endif
+
+// Slot storage for `depth` frames of `chips` panels of `rows` rows each.
+// depth is a power of two (1, 2, 4, ...) up to 128.
+#define AW_FLUSH_QUEUE_SIZE(rows, chips, depth) ((uint16_t)(chips) * AW_FRAME_SIZE(rows) * (depth))
+
+//* AW20216SFlushTask Class Definition */
+
+class AW20216SFlushTask
+{
+public:
+    /**
+     * @brief Queue frames for a set of drivers.
+     *
+     * A frame is the framebuffers of all chips back to back (chip 0 first,
+     * AW_FRAME_SIZE(rows) bytes each, see chipOffset()).
+     *
+     * @param chips Drivers to flush, begin()'d before start() (the array
+     *              and the drivers must outlive the pipeline).
+     * @param count Number of drivers.
+     * @param slots Slot storage, AW_FLUSH_QUEUE_SIZE(rows, count, depth).
+     * @param size  Bytes at slots.
+     * @param depth Frames the queue holds; rounded down to a power of two
+     *              and to what fits in size.
+     */
+    AW20216SFlushTask(AW20216SBase *const *chips, uint8_t count, uint8_t *slots, uint16_t size,
+                      uint8_t depth);
+
+    //==================== Producer (renderer) ====================//
+
+    /**
+     * @brief Reserve the next free slot to render into (zero copy).
+     *
+     * @return frameBytes() bytes to fill, then commitFrame(); nullptr when
+     *         the queue is full (the frame counts as dropped).
+     */
+    uint8_t *acquireFrame();
+
+    /**
+     * @brief Publish the slot returned by acquireFrame() to the flush side.
+     */
+    void commitFrame();
+
+    /**
+     * @brief Copy a whole frame into the queue.
+     *
+     * Safe against the flush task running on the other core; one producer
+     * at a time (several rendering tasks need a mutex around this call).
+     *
+     * @param frame frameBytes() bytes.
+     * @return false if the queue was full and the frame was dropped.
+     */
+    bool submitFrame(const uint8_t *frame);
+
+    //==================== Consumer (flush side) ====================//
+
+    /**
+     * @brief Show the oldest queued frame on every chip.
+     *
+     * The flush task calls this; without AW_HAS_FREERTOS call it from the
+     * context that owns the SPI bus.
+     *
+     * @return false if the queue was empty.
+     */
+    bool service();
+
+#if AW_HAS_FREERTOS
+    /**
+     * @brief Start the flush task.
+     *
+     * @param core     Core to pin the task to (0 or 1), or tskNO_AFFINITY.
+     * @param priority FreeRTOS priority.
+     * @param stack    Stack size in bytes.
+     * @return false if the task is already running or could not be created.
+     */
+    bool start(BaseType_t core = AW_FLUSH_TASK_CORE, UBaseType_t priority = AW_FLUSH_TASK_PRIORITY,
+               uint32_t stack = AW_FLUSH_TASK_STACK);
+
+    /**
+     * @brief Let the task finish the frame in flight, then delete it.
+     *
+     * Queued frames stay queued. Do not call from the flush task.
+     */
+    void stop();
+
+    /** @brief true while the flush task exists. */
+    inline bool running() const { return _task != nullptr; }
+#endif
+
+    //==================== Status (either side) ====================//
+
+    /** @brief Frames waiting to be flushed. */
+    inline uint8_t queued() const { return (uint8_t)(_loadHead() - _loadTail()); }
+
+    /** @brief Slots in the queue. */
+    inline uint8_t capacity() const { return _depth; }
+
+    /** @brief Highest queued() seen by the producer. */
+    inline uint8_t maxQueued() const { return _maxQueued; }
+
+    /** @brief Frames refused because the queue was full. */
+    inline uint32_t dropped() const { return _dropped; }
+
+    /** @brief Frames flushed to the chips. */
+    inline uint32_t framesShown() const { return _shown; }
+
+    /** @brief Bytes of one frame (all chips). */
+    inline uint16_t frameBytes() const { return _frameBytes; }
+
+    /**
+     * @brief Offset of a chip's framebuffer inside a frame.
+     *
+     * @param chip Index in the chips array.
+     */
+    uint16_t chipOffset(uint8_t chip) const;
+
+private:
+    AW20216SBase *const *_chips;
+    uint8_t _count;
+    uint8_t *_slots;
+    uint8_t _depth;       // Power of two
+    uint16_t _frameBytes;
+
+    // Free-running counters: slot = counter & (_depth - 1). _head is only
+    // written by the producer, _tail only by the consumer.
+    uint8_t _head;
+    uint8_t _tail;
+    bool _acquired;       // Producer holds the slot at _head
+
+    uint8_t _maxQueued;   // Producer side
+    uint32_t _dropped;    // Producer side
+    uint32_t _shown;      // Consumer side
+
+#if AW_HAS_FREERTOS
+    TaskHandle_t volatile _task;
+    volatile bool _stopping;
+
+    /**
+     * @brief Task body: flush every queued frame, sleep until notified.
+     */
+    static void _taskMain(void *self);
+#endif
+
+    inline uint8_t _loadHead() const { return __atomic_load_n(&_head, __ATOMIC_ACQUIRE); }
+    inline uint8_t _loadTail() const { return __atomic_load_n(&_tail, __ATOMIC_ACQUIRE); }
+
+    inline uint8_t *_slot(uint8_t counter) const
+    {
+        return _slots + (uint16_t)(counter & (uint8_t)(_depth - 1u)) * _frameBytes;
+    }
+};
+
+/**
+ * @brief AW20216SFlushTask with its slot storage.
+ *
+ * @tparam Depth Queue slots, a power of two (1-128).
+ * @tparam Rows  Rows of each panel, 1-12.
+ * @tparam Chips Panels per frame.
+ *
+ * @code
+ * AW20216SFlushTaskT<4> flush(&ledMatrixPtr, 1);
+ * flush.start();                     // core 0, loop() keeps core 1
+ * // loop(): canvas.captureFrame(slot) / flush.submitFrame(frame)
+ * @endcode
+ */
+template <uint8_t Depth, uint8_t Rows = AW_MAX_ROWS, uint8_t Chips = 1>
+class AW20216SFlushTaskT : public AW20216SFlushTask
+{
+    static_assert(Depth >= 1 && Depth <= 128 && (Depth & (Depth - 1)) == 0,
+                  "AW20216SFlushTaskT: Depth must be a power of two, 1-128");
+    static_assert(Rows >= 1 && Rows <= AW_MAX_ROWS, "AW20216SFlushTaskT: Rows must be 1-12");
+
+public:
+    /**
+     * @brief Queue frames for up to Chips drivers of up to Rows rows
+     *        (a queue too small for the drivers given gets fewer slots).
+     */
+    AW20216SFlushTaskT(AW20216SBase *const *chips, uint8_t count)
+        : AW20216SFlushTask(chips, count, _storage, sizeof(_storage), Depth) {}
+
+private:
+    uint8_t _storage[AW_FLUSH_QUEUE_SIZE(Rows, Chips, Depth)];
+};
+
+#endif // AW20216S_FLUSH_TASK_H
@@ -0,0 +1,188 @@
+#include "AW20216SFrameLoop.h"
+
+//******************************************************** */
+
+/**
+ * @brief Pace a single panel.
+ *
+ * @param driver Panel flushed with show() after each render.
+ * @param render Frame render callback.
+ * @param ctx    Opaque pointer passed to render.
+ */
+AW20216SFrameLoop::AW20216SFrameLoop(AW20216SBase &driver, AwRenderFn render, void *ctx)
+{
+    _init(render, ctx);
+    _driver = &driver;
+}
+
+/**
+ * @brief Pace a panel array.
+ *
+ * @param wall   Array flushed with showAll() after each render.
+ * @param render Frame render callback.
+ * @param ctx    Opaque pointer passed to render.
+ */
+AW20216SFrameLoop::AW20216SFrameLoop(AW20216SArrayBase &wall, AwRenderFn render, void *ctx)
+{
+    _init(render, ctx);
+    _wall = &wall;
+}
+
+/**
+ * @brief Shared constructor body: no target, no schedule yet.
+ *
+ * @param render Frame render callback.
+ * @param ctx    Opaque pointer passed to render.
+ */
+void AW20216SFrameLoop::_init(AwRenderFn render, void *ctx)
+{
+    _driver = nullptr;
+    _wall = nullptr;
+    _render = render;
+    _ctx = ctx;
+    _fps = 0;
+    _policy = AwFramePolicy::Skip;
+    _periodUs = 0;
+    _deadline = 0;
+    _frame = 0;
+    resetStats();
+}
+
+//******************************************************** */
+
+/**
+ * @brief Start pacing at fps; the first frame is due now.
+ *
+ * @param fps    Target frame rate (0 is treated as 1).
+ * @param policy Late-frame policy.
+ */
+void AW20216SFrameLoop::begin(uint16_t fps, AwFramePolicy policy)
+{
+    _policy = policy;
+    setFps(fps);
+    _deadline = micros();
+    _frame = 0;
+    resetStats();
+}
+
+/**
+ * @brief Render and flush one frame if its deadline has come.
+ *
+ * @return true if a frame was rendered; false until begin() or setFps()
+ *         sets a rate.
+ */
+bool AW20216SFrameLoop::poll()
+{
+    if (_periodUs == 0)
+        return false; // No rate yet: begin() / setFps() not called
+
+    const uint32_t now = micros();
+    if ((int32_t)(now - _deadline) < 0)
+        return false; // Not due yet (wrap-safe)
+
+    // Whole periods elapsed since this slot was due.
+    const uint32_t late = (now - _deadline) / _periodUs;
+    if (late > 0)
+    {
+        if (_policy == AwFramePolicy::Skip || late > AW_FRAME_MAX_CATCHUP)
+        {
+            // Drop the stale slots; the current one is rendered on time.
+            _frame += late;
+            _deadline += late * _periodUs;
+            _missed += late;
+            _skipped += late;
+        }
+        else
+        {
+            // Render the oldest pending slot now, late.
+            _missed++;
+        }
+    }
+
+    const uint32_t t0 = micros();
+    _render(_frame, _ctx);
+    const uint32_t t1 = micros();
+    if (_wall != nullptr)
+        _wall->showAll();
+    else
+        _driver->show();
+    const uint32_t t2 = micros();
+
+    const uint32_t renderUs = t1 - t0;
+    const uint32_t flushUs = t2 - t1;
+
+    _frames++;
+    _renderSumUs += renderUs;
+    _flushSumUs += flushUs;
+    if (renderUs < _renderMinUs)
+        _renderMinUs = renderUs;
+    if (renderUs > _renderMaxUs)
+        _renderMaxUs = renderUs;
+    if (flushUs < _flushMinUs)
+        _flushMinUs = flushUs;
+    if (flushUs > _flushMaxUs)
+        _flushMaxUs = flushUs;
+    if (t2 - t0 > _periodUs)
+        _overruns++;
+
+    _frame++;
+    _deadline += _periodUs;
+    return true;
+}
+
+/**
+ * @brief Change the target frame rate.
+ *
+ * @param fps Frames per second (0 is treated as 1).
+ */
+void AW20216SFrameLoop::setFps(uint16_t fps)
+{
+    if (fps == 0)
+        fps = 1;
+
+    // Keep the last frame's slot start and re-space from there.
+    const uint32_t lastStart = _deadline - _periodUs;
+    _fps = fps;
+    _periodUs = 1000000UL / fps;
+    _deadline = lastStart + _periodUs;
+}
+
+//******************************************************** */
+
+/**
+ * @brief Snapshot of the statistics with the averages computed.
+ *
+ * @return Counters and min/avg/max times; all times 0 before the first frame.
+ */
+AwFrameStats AW20216SFrameLoop::stats() const
+{
+    AwFrameStats s;
+    s.frames = _frames;
+    s.missed = _missed;
+    s.skipped = _skipped;
+    s.overruns = _overruns;
+    s.renderMinUs = _frames ? _renderMinUs : 0;
+    s.renderAvgUs = _frames ? (uint32_t)(_renderSumUs / _frames) : 0;
+    s.renderMaxUs = _renderMaxUs;
+    s.flushMinUs = _frames ? _flushMinUs : 0;
+    s.flushAvgUs = _frames ? (uint32_t)(_flushSumUs / _frames) : 0;
+    s.flushMaxUs = _flushMaxUs;
+    return s;
+}
+
+/**
+ * @brief Clear all counters and times.
+ */
+void AW20216SFrameLoop::resetStats()
+{
+    _frames = 0;
+    _missed = 0;
+    _skipped = 0;
+    _overruns = 0;
+    _renderMinUs = 0xFFFFFFFFUL;
+    _renderMaxUs = 0;
+    _flushMinUs = 0xFFFFFFFFUL;
+    _flushMaxUs = 0;
+    _renderSumUs = 0;
+    _flushSumUs = 0;
+}
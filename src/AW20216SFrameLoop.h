@@ -0,0 +1,180 @@
+#ifndef AW20216S_FRAME_LOOP_H
+#define AW20216S_FRAME_LOOP_H
+
+#include "AW20216S.h"
+#include "AW20216SArray.h"
+
+/**
+ * Fixed-timestep frame pacing.
+ *
+ * AW20216SFrameLoop calls a render function and then show() (or
+ * AW20216SArray::showAll()) at a target frame rate from loop(). It counts
+ * frames on a fixed grid of deadlines, so a slow frame does not make the
+ * animation drift, and it records render / flush times and missed deadlines
+ * to size the fps target of a board.
+ */
+
+// Slots a CatchUp loop may fall behind before it gives up and skips ahead.
+#ifndef AW_FRAME_MAX_CATCHUP
+#define AW_FRAME_MAX_CATCHUP 4
+#endif
+
+// What poll() does once it is late by one or more whole frame periods.
+enum class AwFramePolicy : uint8_t {
+    Skip    = 0, // Drop the missed slots: the frame index jumps to real time
+    CatchUp = 1  // Render the missed slots back-to-back, then settle again
+};
+
+// Frame-time statistics since begin() / resetStats(). Times in microseconds.
+struct AwFrameStats
+{
+    uint32_t frames;      // Frames rendered and flushed
+    uint32_t missed;      // Slots that started (or were dropped) past their period
+    uint32_t skipped;     // Slots dropped without rendering
+    uint32_t overruns;    // Frames whose render + flush took longer than a period
+    uint32_t renderMinUs; // Render callback time
+    uint32_t renderAvgUs;
+    uint32_t renderMaxUs;
+    uint32_t flushMinUs;  // show() / showAll() time
+    uint32_t flushAvgUs;
+    uint32_t flushMaxUs;
+};
+
+// Render callback: draw frame number `frame` (0, 1, 2... on the fixed grid,
+// so frame * periodMicros() is the animation time).
+typedef void (*AwRenderFn)(uint32_t frame, void *ctx);
+
+//* AW20216SFrameLoop Class Definition */
+
+class AW20216SFrameLoop
+{
+public:
+    /**
+     * @brief Pace one panel: render, then driver.show().
+     *
+     * @param driver Panel to flush after each render.
+     * @param render Draws one frame into the framebuffer.
+     * @param ctx    Opaque pointer passed to render.
+     */
+    AW20216SFrameLoop(AW20216SBase &driver, AwRenderFn render, void *ctx = nullptr);
+
+    /**
+     * @brief Pace a panel array: render, then wall.showAll().
+     *
+     * @param wall   Array to flush after each render.
+     * @param render Draws one frame into the world framebuffer.
+     * @param ctx    Opaque pointer passed to render.
+     */
+    AW20216SFrameLoop(AW20216SArrayBase &wall, AwRenderFn render, void *ctx = nullptr);
+
+    /**
+     * @brief Start pacing; the first frame is due immediately.
+     *
+     * @param fps    Target frames per second (0 is treated as 1).
+     * @param policy What to do when poll() runs late (see AwFramePolicy).
+     * @note Resets the frame index and the statistics.
+     */
+    void begin(uint16_t fps, AwFramePolicy policy = AwFramePolicy::Skip);
+
+    /**
+     * @brief Call from loop(): renders and flushes one frame if it is due.
+     *
+     * Never blocks. With Skip, a late poll() drops the whole periods it
+     * missed and renders the current slot; with CatchUp it renders the
+     * oldest pending slot, so the next poll() is due at once, until it is
+     * back on schedule (or more than AW_FRAME_MAX_CATCHUP slots behind,
+     * where it skips like Skip). Does nothing until begin() or setFps() sets
+     * a rate.
+     *
+     * @return true if a frame was rendered.
+     */
+    bool poll();
+
+    /**
+     * @brief Change the frame rate; the next frame is due one new period
+     *        after the last one.
+     */
+    void setFps(uint16_t fps);
+
+    /** @brief Target frames per second. */
+    inline uint16_t fps() const { return _fps; }
+
+    /** @brief Frame period in microseconds. */
+    inline uint32_t periodMicros() const { return _periodUs; }
+
+    /** @brief Index of the next frame to render. */
+    inline uint32_t frame() const { return _frame; }
+
+    /**
+     * @brief Statistics since begin() / resetStats(), averages computed.
+     */
+    AwFrameStats stats() const;
+
+    /**
+     * @brief Clear the statistics (the schedule is not touched).
+     */
+    void resetStats();
+
+    /**
+     * @brief Print the statistics as one line, e.g. to Serial:
+     *
+     *   fps=50 frames=500 missed=0 skipped=0 overruns=0
+     *   render_us=410/415/980 flush_us=120/180/340   (min/avg/max)
+     *
+     * @param out Any Print-like object (Serial, a Stream, ...).
+     */
+    template <class Out>
+    void printStats(Out &out) const
+    {
+        const AwFrameStats s = stats();
+        out.print("fps=");
+        out.print((unsigned long)_fps);
+        out.print(" frames=");
+        out.print((unsigned long)s.frames);
+        out.print(" missed=");
+        out.print((unsigned long)s.missed);
+        out.print(" skipped=");
+        out.print((unsigned long)s.skipped);
+        out.print(" overruns=");
+        out.print((unsigned long)s.overruns);
+        out.print(" render_us=");
+        _printTriple(out, s.renderMinUs, s.renderAvgUs, s.renderMaxUs);
+        out.print(" flush_us=");
+        _printTriple(out, s.flushMinUs, s.flushAvgUs, s.flushMaxUs);
+        out.println();
+    }
+
+private:
+    AW20216SBase *_driver;    // Single panel, or nullptr
+    AW20216SArrayBase *_wall; // Panel array, or nullptr
+    AwRenderFn _render;
+    void *_ctx;
+
+    uint16_t _fps;
+    AwFramePolicy _policy;
+    uint32_t _periodUs;
+    uint32_t _deadline; // micros() at which frame _frame is due
+    uint32_t _frame;    // Next frame index
+
+    uint32_t _frames, _missed, _skipped, _overruns;
+    uint32_t _renderMinUs, _renderMaxUs;
+    uint32_t _flushMinUs, _flushMaxUs;
+    uint64_t _renderSumUs, _flushSumUs; // Averages over hours of frames
+
+    /**
+     * @brief Shared constructor body.
+     */
+    void _init(AwRenderFn render, void *ctx);
+
+    template <class Out>
+    static void _printTriple(Out &out, uint32_t lo, uint32_t avg, uint32_t hi)
+    {
+        out.print((unsigned long)lo);
+        out.print("/");
+        out.print((unsigned long)avg);
+        out.print("/");
+        out.print((unsigned long)hi);
+    }
+};
+
+#endif // AW20216S_FRAME_LOOP_H
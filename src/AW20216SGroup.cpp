@@ -0,0 +1,551 @@
+#include "AW20216SGroup.h"
+
+//******************************************************** */
+
+/**
+ * @brief Bind the group to its drivers.
+ *
+ * @param chips Drivers sharing one bus.
+ * @param count Number of drivers.
+ */
+AW20216SGroup::AW20216SGroup(AW20216SBase *const *chips, uint8_t count)
+{
+    _chips = chips;
+    _count = count;
+    _bus.bind(this);
+}
+
+/**
+ * @brief Start every chip: one reset, one OTP wait, one enable burst.
+ *
+ * @return true if every chip's GCR reads back as written.
+ */
+bool AW20216SGroup::begin()
+{
+    for (uint8_t i = 0; i < _count; i++)
+        _chips[i]->_beginBus();
+    delay(20); // Small delay to ensure proper startup
+
+    // Software reset of all chips on one CS edge, then a single OTP wait.
+    Cmd cmd = {OpWrite, AwPattern::PWM, {AW20216S_PAGE0, AW_REG_RSTN, AW_RST_CMD}, false};
+    _run(cmd, true);
+    delay(AW_RESET_DELAY);
+    for (uint8_t i = 0; i < _count; i++)
+        _chips[i]->_afterReset();
+
+    // GCR carries the row count: one frame for all only if the rows match.
+    cmd.op = OpEnable;
+    _run(cmd, _sameGeometry());
+
+    // Reads go to one chip at a time.
+    bool ok = true;
+    for (uint8_t i = 0; i < _count; i++)
+    {
+        AW20216SBase *chip = _chips[i];
+        const uint8_t gcrExpected = (uint8_t)(AW_GCR_SWSEL(chip->_rows) | AW_GLOBAL_ENABLE);
+        if (chip->readRegister(AW20216S_PAGE0, AW_REG_GCR) != gcrExpected)
+            ok = false;
+    }
+    return ok;
+}
+
+//******************************************************** */
+
+/**
+ * @brief Write the global current register (GCCR) of every chip.
+ *
+ * @param current Master current, 0 (off) - 255 (max drive).
+ */
+void AW20216SGroup::setGlobalCurrent(uint8_t current)
+{
+    const Cmd cmd = {OpCurrent, AwPattern::PWM, {current}, false};
+    _run(cmd, true);
+}
+
+/**
+ * @brief Burst-write per-channel scaling (Page 2) to every pixel of every chip.
+ *
+ * @param r_scale Red   channel scale, 0-255.
+ * @param g_scale Green channel scale, 0-255.
+ * @param b_scale Blue  channel scale, 0-255.
+ */
+void AW20216SGroup::setScaling(uint8_t r_scale, uint8_t g_scale, uint8_t b_scale)
+{
+    const Cmd cmd = {OpScaling, AwPattern::PWM, {r_scale, g_scale, b_scale}, false};
+    _run(cmd, _sameGeometry());
+}
+
+/**
+ * @brief Set the PWM frequency and phase scheme of every chip.
+ *
+ * @param freq  PWM frequency (AwPwmFreq).
+ * @param phase PWM phase scheme (AwPwmPhase).
+ */
+void AW20216SGroup::setPwmFrequency(AwPwmFreq freq, AwPwmPhase phase)
+{
+    const Cmd cmd = {OpPwmFreq, AwPattern::PWM, {(uint8_t)freq, (uint8_t)phase}, false};
+    _run(cmd, true);
+}
+
+/**
+ * @brief Program the T0-T3 timings of a PATx engine on every chip.
+ *
+ * @param pat         Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
+ * @param t0          Phase 0 rise time, 0-255.
+ * @param t1          Phase 1 on time, 0-255.
+ * @param t2          Phase 2 fall time, 0-255.
+ * @param t3          Phase 3 off time, 0-255.
+ * @param logarithmic true for logarithmic ramp, false for linear.
+ */
+void AW20216SGroup::configureBreathing(AwPattern pat, uint8_t t0, uint8_t t1, uint8_t t2,
+                                       uint8_t t3, bool logarithmic)
+{
+    const Cmd cmd = {OpConfigure, pat, {t0, t1, t2, t3}, logarithmic};
+    _run(cmd, _samePage0(cmd));
+}
+
+/**
+ * @brief Set the min/max envelope of a PATx engine on every chip.
+ *
+ * @param pat  Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
+ * @param minV Minimum brightness, 0-255.
+ * @param maxV Maximum brightness, 0-255.
+ */
+void AW20216SGroup::setBreathingBrightness(AwPattern pat, uint8_t minV, uint8_t maxV)
+{
+    const Cmd cmd = {OpBrightness, pat, {minV, maxV}, false};
+    _run(cmd, _samePage0(cmd));
+}
+
+/**
+ * @brief Program timers, envelope and config of a PATx engine on every chip.
+ *
+ * @param pat         Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
+ * @param t0          Phase 0 rise time, 0-255.
+ * @param t1          Phase 1 on time, 0-255.
+ * @param t2          Phase 2 fall time, 0-255.
+ * @param t3          Phase 3 off time, 0-255.
+ * @param minV        Minimum brightness, 0-255.
+ * @param maxV        Maximum brightness, 0-255.
+ * @param logarithmic true for logarithmic ramp, false for linear.
+ */
+void AW20216SGroup::setupBreathing(AwPattern pat, uint8_t t0, uint8_t t1, uint8_t t2, uint8_t t3,
+                                   uint8_t minV, uint8_t maxV, bool logarithmic)
+{
+    const Cmd cmd = {OpSetup, pat, {t0, t1, t2, t3, minV, maxV}, logarithmic};
+    _run(cmd, _samePage0(cmd));
+}
+
+/**
+ * @brief Trigger a breathing engine on every chip with one PATGO write.
+ *
+ * @param pat Pattern engine: PAT0, PAT1 or PAT2 (PWM is ignored).
+ */
+void AW20216SGroup::startBreathing(AwPattern pat)
+{
+    const Cmd cmd = {OpStart, pat, {0}, false};
+    _run(cmd, true);
+}
+
+/**
+ * @brief Write one register of every chip.
+ *
+ * @param page  Target page, 0-4.
+ * @param reg   Register address.
+ * @param value Byte to write.
+ */
+void AW20216SGroup::writeRegister(uint8_t page, uint8_t reg, uint8_t value)
+{
+    const Cmd cmd = {OpWrite, AwPattern::PWM, {page, reg, value}, false};
+    _run(cmd, true);
+}
+
+//******************************************************** */
+
+/**
+ * @brief Load one frame into every driver and show it with one burst.
+ *
+ * @param frame Framebuffer bytes of the active rows.
+ */
+void AW20216SGroup::showFrame(const uint8_t *frame)
+{
+    if (_count == 0)
+        return;
+
+    bool uniform = _sameGeometry();
+    AW20216SBase *lead = _chips[0];
+    const uint8_t n = (uint8_t)AW_BASE_Y(lead->_rows);
+
+    for (uint8_t i = 0; i < _count; i++)
+    {
+        AW20216SBase *chip = _chips[i];
+        const uint8_t len = (uint8_t)AW_BASE_Y(chip->_rows);
+
+        chip->waitShow();
+        memcpy(chip->_frameBuffer, frame, len);
+        chip->_markDirty(0, (uint8_t)(len - 1u));
+
+        // Streamed (viewport / palette) or translated frames differ per chip.
+        if (chip->_viewport != nullptr || chip->_indexed != nullptr ||
+            chip->_outputLut != lead->_outputLut || chip->_frameless())
+            uniform = false;
+    }
+
+    if (uniform)
+    {
+        // The delta only fits every chip if they all hold the same frame.
+        bool same = lead->_shadowValid;
+        for (uint8_t i = 1; i < _count && same; i++)
+        {
+            const AW20216SBase *chip = _chips[i];
+            same = chip->_shadowValid && memcmp(chip->_chipShadow, lead->_chipShadow, n) == 0;
+        }
+        if (!same)
+        {
+            for (uint8_t i = 0; i < _count; i++)
+                _chips[i]->invalidate();
+        }
+    }
+
+    const Cmd cmd = {OpShow, AwPattern::PWM, {0}, false};
+    _run(cmd, uniform);
+}
+
+//******************************************************** */
+
+/**
+ * @brief true if all chips sit on one SPIClass, all with or all without a
+ *        transport.
+ */
+bool AW20216SGroup::_sharedBus() const
+{
+    for (uint8_t i = 1; i < _count; i++)
+    {
+        if (_chips[i]->_spiPort != _chips[0]->_spiPort ||
+            (_chips[i]->_transport == nullptr) != (_chips[0]->_transport == nullptr))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief true if all chips scan the same rows with the same frame size.
+ */
+bool AW20216SGroup::_sameGeometry() const
+{
+    for (uint8_t i = 1; i < _count; i++)
+    {
+        if (_chips[i]->_rows != _chips[0]->_rows ||
+            _chips[i]->_frameSize != _chips[0]->_frameSize)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief true if a breathing command's burst would carry the same bytes to
+ *        every chip.
+ *
+ * The burst resends the neighbouring engines' registers (and this engine's
+ * PATxCFG bits) from the first driver's Page 0 copy, so those must be known
+ * and equal on every chip. Registers the command sets outright are skipped.
+ *
+ * @param cmd OpConfigure, OpBrightness or OpSetup.
+ */
+bool AW20216SGroup::_samePage0(const Cmd &cmd) const
+{
+    if (cmd.pat == AwPattern::PWM)
+        return true; // Ignored by every driver
+
+    const uint8_t idx = AW_PAT_INDEX(cmd.pat);
+    const uint8_t tBase = AW_PAT_T_BASE(idx);
+    const uint8_t pwmH = (uint8_t)(AW_REG_PWMH0 + idx);
+    const uint8_t pwmL = (uint8_t)(AW_REG_PWML0 + idx);
+    const bool setsTimers = cmd.op != OpBrightness;
+    const bool setsEnvelope = cmd.op != OpConfigure;
+    const uint8_t lo = setsEnvelope ? pwmH : tBase;
+    const uint8_t hi = (cmd.op == OpBrightness) ? pwmL : AW_PAT_CFG_ADDR(idx);
+    const AW20216SBase *lead = _chips[0];
+
+    for (uint8_t reg = lo; reg <= hi; reg++)
+    {
+        if ((setsEnvelope && (reg == pwmH || reg == pwmL)) ||
+            (setsTimers && reg >= tBase && reg < tBase + 4u))
+            continue;
+
+        const uint8_t bit = (uint8_t)(1u << (reg & 7u));
+        if (!(lead->_page0Known[reg >> 3] & bit))
+            return false;
+        for (uint8_t i = 1; i < _count; i++)
+        {
+            const AW20216SBase *chip = _chips[i];
+            if (!(chip->_page0Known[reg >> 3] & bit) || chip->_page0[reg] != lead->_page0[reg])
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Run a command on one driver through its public API.
+ *
+ * @param chip Driver.
+ * @param cmd  Command.
+ */
+void AW20216SGroup::_apply(AW20216SBase *chip, const Cmd &cmd)
+{
+    const uint8_t *v = cmd.v;
+
+    switch (cmd.op)
+    {
+    case OpWrite:
+        chip->writeRegister(v[0], v[1], v[2]);
+        break;
+    case OpEnable:
+        chip->writeRegister(AW20216S_PAGE0, AW_REG_GCR,
+                            (uint8_t)(AW_GCR_SWSEL(chip->_rows) | AW_GLOBAL_ENABLE));
+        chip->setGlobalCurrent(0x80);
+        break;
+    case OpCurrent:
+        chip->setGlobalCurrent(v[0]);
+        break;
+    case OpScaling:
+        chip->setScaling(v[0], v[1], v[2]);
+        break;
+    case OpPwmFreq:
+        chip->setPwmFrequency((AwPwmFreq)v[0], (AwPwmPhase)v[1]);
+        break;
+    case OpConfigure:
+        chip->configureBreathing(cmd.pat, v[0], v[1], v[2], v[3], cmd.flag);
+        break;
+    case OpBrightness:
+        chip->setBreathingBrightness(cmd.pat, v[0], v[1]);
+        break;
+    case OpSetup:
+        chip->setupBreathing(cmd.pat, v[0], v[1], v[2], v[3], v[4], v[5], cmd.flag);
+        break;
+    case OpStart:
+        chip->startBreathing(cmd.pat);
+        break;
+    case OpShow:
+        chip->show();
+        break;
+    }
+}
+
+/**
+ * @brief Broadcast a command through the first driver, then bring the
+ *        other drivers' RAM copies along by replaying it with writes muted.
+ *
+ * @param cmd     Command.
+ * @param uniform true if every chip would receive the same bytes.
+ */
+void AW20216SGroup::_run(const Cmd &cmd, bool uniform)
+{
+    for (uint8_t i = 0; i < _count; i++)
+        _chips[i]->waitShow();
+
+    if (_count < 2 || !uniform || !_sharedBus())
+    {
+        for (uint8_t i = 0; i < _count; i++)
+            _apply(_chips[i], cmd);
+        return;
+    }
+
+    _bus.attach(_chips[0], true);
+    _apply(_chips[0], cmd);
+    _bus.detach();
+
+    for (uint8_t i = 1; i < _count; i++)
+    {
+        AW20216SBase *chip = _chips[i];
+#if AW_ENABLE_STATS
+        // The broadcast is counted once, by the first driver.
+        const AwDriverStats stats = chip->_stats;
+#endif
+        _bus.attach(chip, false);
+        _apply(chip, cmd);
+        _bus.detach();
+#if AW_ENABLE_STATS
+        chip->_stats = stats;
+#endif
+    }
+}
+
+//******************************************************** */
+
+/**
+ * @brief Install the bus on a driver for one group call.
+ *
+ * @param owner     Driver whose call runs next.
+ * @param broadcast true: writes go to every chip; false: writes are dropped.
+ */
+void AW20216SGroup::Bus::attach(AW20216SBase *owner, bool broadcast)
+{
+    _owner = owner;
+    _ownerTransport = owner->_transport;
+    owner->_transport = this;
+    _broadcast = broadcast;
+    _txWanted = false;
+    _txOpen = false;
+    _frame = Idle;
+}
+
+/**
+ * @brief Give the driver its own transport back.
+ */
+void AW20216SGroup::Bus::detach()
+{
+    if (_txOpen)
+        endTransaction();
+    _owner->_transport = _ownerTransport;
+    _owner = nullptr;
+}
+
+/**
+ * @brief Release the real bus if a frame took it.
+ */
+void AW20216SGroup::Bus::endTransaction()
+{
+    if (_txOpen)
+    {
+        if (_ownerTransport != nullptr)
+            _ownerTransport->endTransaction();
+        else
+            _owner->_spiPort->endTransaction();
+        _txOpen = false;
+    }
+    _txWanted = false;
+}
+
+/**
+ * @brief Close the CS frame on the chips it selected.
+ */
+void AW20216SGroup::Bus::deselect()
+{
+    if (_frame == All)
+    {
+        _csAll(false);
+#if AW_ENABLE_STATS
+        // The driver counted its own CS edges; add the other chips'.
+        _owner->_stats.csToggles += 2u * (_group->_count - 1u);
+#endif
+    }
+    else if (_frame == Owner)
+        _cs(_owner, false);
+    _frame = Idle;
+}
+
+/**
+ * @brief Shift one byte; the first byte of a frame picks its chips.
+ *
+ * @param b Byte to send.
+ * @return Byte read (0 for a muted frame).
+ */
+uint8_t AW20216SGroup::Bus::transfer(uint8_t b)
+{
+    if (_frame == Pending)
+        _open(b);
+    if (_frame == Muted)
+        return 0;
+    return _xfer(b);
+}
+
+/**
+ * @brief Send bytes on the owner's bus (nothing for a muted frame).
+ *
+ * @param data Bytes to send.
+ * @param len  Number of bytes.
+ */
+void AW20216SGroup::Bus::write(const uint8_t *data, uint16_t len)
+{
+    if (len == 0)
+        return;
+    if (_frame == Pending)
+        _open(data[0]);
+    if (_frame == Muted)
+        return;
+
+    if (_ownerTransport != nullptr)
+    {
+        _ownerTransport->write(data, len);
+        return;
+    }
+
+#if AW_HAS_SPI_WRITE_BYTES
+    _owner->_spiPort->writeBytes(data, (uint32_t)len);
+#elif AW_HAS_SPI_ASYNC_TRANSFER
+    _owner->_spiPort->transfer(data, nullptr, (size_t)len, true);
+#else
+    while (len--)
+        _owner->_spiPort->transfer(*data++);
+#endif
+}
+
+/**
+ * @brief Pick the chips of a new frame from its command byte and select them.
+ *
+ * @param command First byte of the frame (bit 0 set: read).
+ */
+void AW20216SGroup::Bus::_open(uint8_t command)
+{
+    if ((command & 0x01u) != 0)
+        _frame = Owner; // MISO has room for one chip
+    else if (_broadcast)
+        _frame = All;
+    else
+    {
+        _frame = Muted; // Already sent by the broadcast
+        return;
+    }
+
+    if (_txWanted && !_txOpen)
+    {
+        if (_ownerTransport != nullptr)
+            _ownerTransport->beginTransaction();
+        else
+            _owner->_spiPort->beginTransaction(SPISettings(AW_SPI_SPEED, MSBFIRST, SPI_MODE0));
+        _txOpen = true;
+    }
+
+    if (_frame == All)
+        _csAll(true);
+    else
+        _cs(_owner, true);
+}
+
+/**
+ * @brief Drive the CS line of every chip in the group.
+ */
+void AW20216SGroup::Bus::_csAll(bool low)
+{
+    for (uint8_t i = 0; i < _group->_count; i++)
+        _cs(_group->_chips[i], low);
+}
+
+/**
+ * @brief Drive one chip's CS line through its own transport or pin.
+ */
+void AW20216SGroup::Bus::_cs(AW20216SBase *chip, bool low)
+{
+    AwTransport *t = (chip == _owner) ? _ownerTransport : chip->_transport;
+    if (t != nullptr)
+    {
+        if (low)
+            t->select();
+        else
+            t->deselect();
+    }
+    else
+    {
+        chip->_cs.write(!low);
+    }
+}
+
+/**
+ * @brief Shift one byte on the owner's bus.
+ */
+uint8_t AW20216SGroup::Bus::_xfer(uint8_t b)
+{
+    return (_ownerTransport != nullptr) ? _ownerTransport->transfer(b) : _owner->_spiPort->transfer(b);
+}
@@ -0,0 +1,199 @@
+#ifndef AW20216S_GROUP_H
+#define AW20216S_GROUP_H
+
+#include "AW20216S.h"
+
+/**
+ * Broadcast writes to several chips on one bus.
+ *
+ * Chips that share SCK / MOSI and differ only in their CS line can take the
+ * same write at once: AW20216SGroup pulls every CS line low for each write
+ * frame, so identical configuration goes out once instead of once per chip,
+ * and a startBreathing() starts the engines of all panels on the same edge.
+ * Every driver's RAM copies (Page 0, patterns, chip shadow) are updated as if
+ * it had been written alone, so per-chip calls keep working afterwards.
+ *
+ * Reads cannot be broadcast (all chips would drive MISO): the few paths that
+ * read the chip run for each chip on its own CS line.
+ */
+
+//* AW20216SGroup Class Definition */
+
+class AW20216SGroup
+{
+public:
+    /**
+     * @brief Group drivers that share one bus.
+     *
+     * The chips must share SCK / MOSI: the same SPIClass (without
+     * transports), or transports on the same data pins. If they do not
+     * share a SPIClass, every call falls back to one write per chip.
+     *
+     * @param chips Drivers (the array and the drivers must outlive the group).
+     * @param count Number of drivers.
+     */
+    AW20216SGroup(AW20216SBase *const *chips, uint8_t count);
+
+    /**
+     * @brief begin() for every chip with one reset / enable / current burst.
+     *
+     * @return true if every chip reads its GCR back (each is checked on its
+     *         own CS line).
+     */
+    bool begin();
+
+    /** @brief setGlobalCurrent() on every chip at once. */
+    void setGlobalCurrent(uint8_t current);
+
+    /** @brief setScaling() on every chip at once (per chip if sizes differ). */
+    void setScaling(uint8_t r_scale, uint8_t g_scale, uint8_t b_scale);
+
+    /** @brief setPwmFrequency() on every chip at once. */
+    void setPwmFrequency(AwPwmFreq freq, AwPwmPhase phase = AwPwmPhase::PhaseDelay);
+
+    /** @brief configureBreathing() on every chip at once (per chip if their
+     *         other engines' timers differ). */
+    void configureBreathing(AwPattern pat, uint8_t t0, uint8_t t1, uint8_t t2, uint8_t t3,
+                            bool logarithmic = false);
+
+    /** @brief setBreathingBrightness() on every chip at once (per chip if
+     *         their other engines' envelopes differ). */
+    void setBreathingBrightness(AwPattern pat, uint8_t minV, uint8_t maxV);
+
+    /** @brief setupBreathing() on every chip at once (per chip if their
+     *         other engines' registers differ). */
+    void setupBreathing(AwPattern pat, uint8_t t0, uint8_t t1, uint8_t t2, uint8_t t3,
+                        uint8_t minV, uint8_t maxV, bool logarithmic = false);
+
+    /**
+     * @brief startBreathing() on every chip in one frame: the engines of all
+     *        panels start on the same CS edge and stay in phase.
+     */
+    void startBreathing(AwPattern pat);
+
+    /**
+     * @brief Show one frame on every chip with a single Page 1 burst.
+     *
+     * The frame is copied into every framebuffer. If the chips last showed
+     * the same content only the changed bytes are sent, otherwise the whole
+     * frame once. Chips in viewport or indexed mode, or of different sizes,
+     * are shown one by one.
+     *
+     * @param frame AW_FRAME_SIZE(rows) bytes, framebuffer layout.
+     */
+    void showFrame(const uint8_t *frame);
+
+    /**
+     * @brief writeRegister() on every chip at once.
+     */
+    void writeRegister(uint8_t page, uint8_t reg, uint8_t value);
+
+    /** @brief Number of chips. */
+    inline uint8_t count() const { return _count; }
+
+    /** @brief Driver i, 0 - (count()-1), for per-chip calls. */
+    inline AW20216SBase &chip(uint8_t i) { return *_chips[i]; }
+
+private:
+    /**
+     * @brief Transport installed on a driver while a group call runs on it.
+     *
+     * Decides per CS frame from the command byte: writes go to every chip
+     * (broadcast) or nowhere (replay on the other drivers, which only
+     * updates their RAM copies); reads go to the owner's chip alone.
+     */
+    class Bus : public AwTransport
+    {
+    public:
+        Bus() : _group(nullptr), _owner(nullptr), _ownerTransport(nullptr), _broadcast(false),
+                _txWanted(false), _txOpen(false), _frame(0) {}
+
+        void bind(AW20216SGroup *group) { _group = group; }
+        void attach(AW20216SBase *owner, bool broadcast);
+        void detach();
+
+        void beginTransaction() override { _txWanted = true; }
+        void endTransaction() override;
+        void select() override { _frame = Pending; }
+        void deselect() override;
+        uint8_t transfer(uint8_t b) override;
+        void write(const uint8_t *data, uint16_t len) override;
+
+    private:
+        enum : uint8_t { Idle = 0, Pending, All, Owner, Muted };
+
+        AW20216SGroup *_group;
+        AW20216SBase *_owner;          // Driver whose call is running
+        AwTransport *_ownerTransport;  // Its own transport (nullptr: SPI)
+        bool _broadcast;               // Writes reach every chip
+        bool _txWanted;                // Driver opened a transaction
+        bool _txOpen;                  // ...and it is open on the bus
+        uint8_t _frame;
+
+        void _open(uint8_t command);
+        void _csAll(bool low);
+        void _cs(AW20216SBase *chip, bool low);
+        uint8_t _xfer(uint8_t b);
+    };
+
+    // One group call, replayed on every driver by _apply().
+    enum : uint8_t
+    {
+        OpWrite = 0,     // writeRegister(v[0], v[1], v[2])
+        OpEnable,        // GCR (CHIPEN + rows) and the default current
+        OpCurrent,       // setGlobalCurrent(v[0])
+        OpScaling,       // setScaling(v[0], v[1], v[2])
+        OpPwmFreq,       // setPwmFrequency(v[0], v[1])
+        OpConfigure,     // configureBreathing(pat, v[0..3], flag)
+        OpBrightness,    // setBreathingBrightness(pat, v[0], v[1])
+        OpSetup,         // setupBreathing(pat, v[0..3], v[4], v[5], flag)
+        OpStart,         // startBreathing(pat)
+        OpShow           // show()
+    };
+
+    struct Cmd
+    {
+        uint8_t op;
+        AwPattern pat;
+        uint8_t v[6];
+        bool flag;
+    };
+
+    AW20216SBase *const *_chips;
+    uint8_t _count;
+    Bus _bus;
+
+    /**
+     * @brief true if one frame reaches every chip: same SPIClass, and all
+     *        chips on transports or none.
+     */
+    bool _sharedBus() const;
+
+    /**
+     * @brief true if every chip has the same rows and frame size.
+     */
+    bool _sameGeometry() const;
+
+    /**
+     * @brief true if every chip's Page 0 copy matches the first driver's over
+     *        the registers a breathing command resends unchanged.
+     */
+    bool _samePage0(const Cmd &cmd) const;
+
+    /**
+     * @brief Run a command on one driver.
+     */
+    static void _apply(AW20216SBase *chip, const Cmd &cmd);
+
+    /**
+     * @brief Run a command once on the bus for every chip, then replay it on
+     *        the other drivers with writes muted (their RAM copies follow).
+     *
+     * @param cmd     Command.
+     * @param uniform true if the command sends the same bytes to every chip;
+     *                false (or no shared bus) runs it chip by chip.
+     */
+    void _run(const Cmd &cmd, bool uniform);
+};
+
+#endif // AW20216S_GROUP_H
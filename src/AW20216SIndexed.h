@@ -0,0 +1,109 @@
+#ifndef AW20216S_INDEXED_H
+#define AW20216S_INDEXED_H
+
+#include "AW20216S.h"
+
+/**
+ * Palette-indexed AW20216S driver.
+ *
+ * AW20216SIndexed keeps the panel as 4 or 8 bits per pixel plus a small
+ * RGB palette and expands it to PWM bytes inside the Page 1 burst. It has
+ * no RGB framebuffer, no chip shadow and no per-LED scaling buffer of its
+ * own: a full 12-row panel keeps 36 (4 bpp) or 72 (8 bpp) bytes of pixels
+ * next to the 72-byte Page 3 copy, instead of two or three 216-byte frames,
+ * which is what lets an AVR drive several chips. The RGB drawing calls of
+ * every indexed driver share one discard frame.
+ */
+
+namespace aw_indexed_detail
+{
+/**
+ * @brief Scratch frame shared by every AW20216SIndexed: RGB drawing calls
+ *        (setPixel(), fillScreen(), ...) land here and are never sent.
+ */
+inline uint8_t *discardFrame()
+{
+    static uint8_t frame[AW_BASE_Y(AW_MAX_ROWS)];
+    return frame;
+}
+} // namespace aw_indexed_detail
+
+//* AW20216SIndexed Class Definition */
+
+/**
+ * @brief Driver whose only framebuffer is an indexed frame and a palette.
+ *
+ * @tparam Bpp     Bits per pixel, 4 (16 colors) or 8 (256 colors).
+ * @tparam Rows    SW lines wired to the matrix, 1-12.
+ * @tparam Entries Palette entries actually stored (up to 1 << Bpp); larger
+ *                 indices show black. A 32-color fire ramp at 8 bpp then
+ *                 costs 96 bytes of palette, not 768.
+ *
+ * Draw with setIndex() / fillIndex(), animate with setPaletteColor() /
+ * rotatePalette(), flush with show(). setActiveRows(), setScaling(),
+ * breathing, the viewport and raw register access work as on AW20216S; the
+ * RGB drawing calls and the per-pixel scaling calls (setPixelScaling(),
+ * setPixel16(), calibration blobs) have no effect.
+ *
+ * @code
+ * AW20216SIndexed<4> life(CS_PIN);   // 36 + 48 bytes of pixels/palette
+ * life.setPaletteColor(1, 0, 180, 40);
+ * life.setIndex(2, 3, 1);
+ * life.show();
+ * @endcode
+ */
+template <uint8_t Bpp, uint8_t Rows = AW_MAX_ROWS, uint16_t Entries = (1u << Bpp)>
+class AW20216SIndexed : public AW20216SBase
+{
+    static_assert(Bpp == 4 || Bpp == 8, "AW20216SIndexed: Bpp must be 4 or 8");
+    static_assert(Rows >= 1 && Rows <= AW_MAX_ROWS, "AW20216SIndexed: Rows must be 1-12");
+    static_assert(Entries >= 1 && Entries <= (1u << Bpp), "AW20216SIndexed: Entries must be 1 - (1 << Bpp)");
+
+public:
+    /**
+     * @brief Construct the driver. Call begin() before any other method.
+     *
+     * All pixels start at index 0 and the palette starts black.
+     *
+     * @param csPin   MCU GPIO used as Chip Select (active LOW).
+     * @param cols    Number of columns (RGB triplets), 1-6.
+     * @param spiPort SPI bus instance driving the chip.
+     */
+    explicit AW20216SIndexed(uint8_t csPin, uint8_t cols = 6, SPIClass &spiPort = SPI)
+        : AW20216SBase(Rows, cols, csPin, spiPort, _storage, Rows, aw_indexed_detail::discardFrame())
+    {
+        memset(_pixels, 0, sizeof(_pixels));
+        memset(_palette, 0, sizeof(_palette));
+        setIndexedFrame(_pixels, Bpp, _palette, Entries);
+    }
+
+    /** @brief Indexed pixel data, AW_INDEXED_SIZE(Rows, Bpp) bytes. */
+    inline uint8_t *pixels() { return _pixels; }
+
+    /** @brief Palette, Entries x 3 bytes (R, G, B). */
+    inline uint8_t *palette() { return _palette; }
+
+    /** @brief Number of palette entries. */
+    static constexpr uint16_t paletteSize() { return Entries; }
+
+    /**
+     * @brief Copy a whole palette in from flash (PROGMEM).
+     *
+     * @param rgb   count x 3 bytes.
+     * @param count Entries to load, from entry 0 (clipped to Entries).
+     * @note RAM-only operation. Call show() to make it visible.
+     */
+    void loadPalette_P(const uint8_t *rgb, uint16_t count)
+    {
+        if (count > Entries)
+            count = Entries;
+        memcpy_P(_palette, rgb, (size_t)count * 3u);
+    }
+
+private:
+    uint8_t _storage[AW_DRIVER_RAM_INDEXED(Rows)];
+    uint8_t _pixels[AW_INDEXED_SIZE(Rows, Bpp)];
+    uint8_t _palette[Entries * 3u];
+};
+
+#endif // AW20216S_INDEXED_H
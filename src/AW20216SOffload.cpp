@@ -0,0 +1,244 @@
+#include "AW20216SOffload.h"
+
+//******************************************************** */
+
+/**
+ * @brief Bind the offloader to a panel; nothing is programmed yet.
+ *
+ * @param driver Panel whose engines are used.
+ */
+AW20216SOffload::AW20216SOffload(AW20216SBase &driver)
+{
+    _driver = &driver;
+    _count = 0;
+    _engines = 0;
+    _fallback = 0;
+}
+
+//******************************************************** */
+
+/**
+ * @brief Compile the effect list onto PAT0-PAT2 and program the chip.
+ *
+ * @param effects Effect list.
+ * @param count   Number of effects (extra ones are ignored).
+ * @return Bit i set if effect i is not offloaded.
+ */
+uint16_t AW20216SOffload::apply(const AwBreathEffect *effects, uint8_t count)
+{
+    if (count > AW_OFFLOAD_MAX_EFFECTS)
+        count = AW_OFFLOAD_MAX_EFFECTS;
+
+    _count = count;
+    _engines = 0;
+    _fallback = 0;
+
+    // 1. Allocation: identical programs share an engine.
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const AwBreathEffect &e = effects[i];
+        Program p;
+        _engineOf[i] = 0xFF;
+
+        if (!timerCodes(e, p.t))
+        {
+            _status[i] = AwOffloadStatus::Range;
+            _fallback |= (uint16_t)(1u << i);
+            continue;
+        }
+
+        p.minV = e.minV;
+        p.maxV = e.maxV;
+        p.group = e.group;
+        p.logarithmic = e.logarithmic;
+
+        _engineOf[i] = _allocate(p);
+        if (_engineOf[i] == 0xFF)
+        {
+            _status[i] = AwOffloadStatus::NoEngine;
+            _fallback |= (uint16_t)(1u << i);
+        }
+        else
+        {
+            _status[i] = AwOffloadStatus::Engine;
+        }
+    }
+
+    // 2. One burst per engine: timers, envelope and config.
+    for (uint8_t k = 0; k < _engines; k++)
+    {
+        const Program &p = _programs[k];
+        _driver->setupBreathing((AwPattern)(k + 1u), p.t[0], p.t[1], p.t[2], p.t[3],
+                                p.minV, p.maxV, p.logarithmic);
+    }
+
+    // 3. Page 3 in RAM, then one burst for every binding.
+    for (uint8_t i = 0; i < count; i++)
+        _driver->setChannelPatternMask(effects[i].rowMasks, effects[i].channels, engine(i));
+    _driver->commitPatterns();
+
+    return _fallback;
+}
+
+/**
+ * @brief Start every used engine at once.
+ */
+void AW20216SOffload::start()
+{
+    const uint8_t bits = _startBits(true, 0);
+    if (bits)
+        _driver->writeRegister(AW20216S_PAGE0, AW_REG_PATGO, bits);
+}
+
+/**
+ * @brief Start the engines of one phase group.
+ *
+ * @param group Phase group to start.
+ */
+void AW20216SOffload::startGroup(uint8_t group)
+{
+    const uint8_t bits = _startBits(false, group);
+    if (bits)
+        _driver->writeRegister(AW20216S_PAGE0, AW_REG_PATGO, bits);
+}
+
+//******************************************************** */
+
+/**
+ * @brief Engine assigned to an effect.
+ *
+ * @param effect Effect index in the last apply().
+ * @return PAT0-PAT2, or PWM if not offloaded / out of range.
+ */
+AwPattern AW20216SOffload::engine(uint8_t effect) const
+{
+    if (effect >= _count || _engineOf[effect] == 0xFF)
+        return AwPattern::PWM;
+    return (AwPattern)(_engineOf[effect] + 1u);
+}
+
+/**
+ * @brief Outcome of an effect.
+ *
+ * @param effect Effect index in the last apply().
+ * @return Engine, NoEngine or Range (Range if the index is unknown).
+ */
+AwOffloadStatus AW20216SOffload::status(uint8_t effect) const
+{
+    return effect < _count ? _status[effect] : AwOffloadStatus::Range;
+}
+
+/**
+ * @brief Engines holding a program after the last apply().
+ *
+ * @return 0-3.
+ */
+uint8_t AW20216SOffload::enginesUsed() const
+{
+    return _engines;
+}
+
+//******************************************************** */
+
+/**
+ * @brief Split an effect's period into T0-T3 timer steps.
+ *
+ * @param e Effect.
+ * @param t Receives rise, on, fall and off steps.
+ * @return false if a phase does not fit in 0-255 steps.
+ */
+bool AW20216SOffload::timerCodes(const AwBreathEffect &e, uint8_t t[4])
+{
+    if (e.periodMs == 0 || (uint16_t)e.dutyPct + 2u * e.rampPct > 100u)
+        return false;
+
+    const uint32_t steps = ((uint32_t)e.periodMs + AW_PAT_TICK_MS / 2u) / AW_PAT_TICK_MS;
+    const uint32_t ramp = (steps * e.rampPct + 50u) / 100u;
+    const uint32_t on = (steps * e.dutyPct + 50u) / 100u;
+    const uint32_t busy = 2u * ramp + on;
+    const uint32_t off = (steps > busy) ? steps - busy : 0u;
+
+    if (ramp > 255u || on > 255u || off > 255u)
+        return false;
+
+    t[0] = (uint8_t)ramp;
+    t[1] = (uint8_t)on;
+    t[2] = (uint8_t)ramp;
+    t[3] = (uint8_t)off;
+    return true;
+}
+
+/**
+ * @brief Effect brightness at a time, computed on the MCU.
+ *
+ * @param e  Effect.
+ * @param ms Milliseconds since the group started.
+ * @return Brightness between minV and maxV.
+ */
+uint8_t AW20216SOffload::level(const AwBreathEffect &e, uint32_t ms)
+{
+    if (e.periodMs == 0)
+        return e.minV;
+
+    const uint32_t pos = ms % e.periodMs;
+    const uint32_t rise = (uint32_t)e.periodMs * e.rampPct / 100u;
+    const uint32_t hold = (uint32_t)e.periodMs * e.dutyPct / 100u;
+
+    uint16_t f; // 0-255 position on the envelope
+    if (pos < rise)
+        f = (uint16_t)(pos * 255u / rise);
+    else if (pos < rise + hold)
+        f = 255u;
+    else if (pos < 2u * rise + hold)
+        f = (uint16_t)(255u - (pos - rise - hold) * 255u / rise);
+    else
+        f = 0u;
+
+    if (e.logarithmic)
+        f = (uint16_t)((f * f + 127u) / 255u);
+
+    return (uint8_t)((int32_t)e.minV + ((int32_t)e.maxV - (int32_t)e.minV) * (int32_t)f / 255);
+}
+
+//******************************************************** */
+
+/**
+ * @brief Find an engine already running p, or take a free one.
+ *
+ * @param p Engine program.
+ * @return Engine index 0-2, or 0xFF if none is left.
+ */
+uint8_t AW20216SOffload::_allocate(const Program &p)
+{
+    for (uint8_t k = 0; k < _engines; k++)
+    {
+        const Program &q = _programs[k];
+        if (memcmp(q.t, p.t, sizeof(p.t)) == 0 && q.minV == p.minV && q.maxV == p.maxV &&
+            q.group == p.group && q.logarithmic == p.logarithmic)
+            return k;
+    }
+
+    if (_engines >= 3)
+        return 0xFF;
+
+    _programs[_engines] = p;
+    return _engines++;
+}
+
+/**
+ * @brief PATGO bits to start a set of engines.
+ *
+ * @param any   true for every used engine, false for one group only.
+ * @param group Group to select when any is false.
+ * @return Bit k set for engine PATk.
+ */
+uint8_t AW20216SOffload::_startBits(bool any, uint8_t group) const
+{
+    uint8_t bits = 0;
+    for (uint8_t k = 0; k < _engines; k++)
+    {
+        if (any || _programs[k].group == group)
+            bits |= (uint8_t)(1u << k);
+    }
+    return bits;
+}
@@ -0,0 +1,156 @@
+#ifndef AW20216S_OFFLOAD_H
+#define AW20216S_OFFLOAD_H
+
+#include "AW20216S.h"
+
+/**
+ * Breathing-engine offload.
+ *
+ * AW20216SOffload takes a list of periodic brightness effects (period, duty,
+ * ramps, min/max, phase group, and the pixels/channels they drive), shares
+ * the chip's three breathing engines PAT0-PAT2 among them, programs the
+ * engines and binds Page 3 in one burst. Effects that do not fit are
+ * reported so the sketch can drive them with show(); everything offloaded
+ * then runs with no SPI traffic and no CPU time per frame.
+ */
+
+// Length of one breathing timer step (one unit of T0-T3) in milliseconds.
+// Calibrate for a board by timing setupBreathing(pat, 100, 100, 100, 100,
+// ...) : one cycle lasts 400 steps.
+#ifndef AW_PAT_TICK_MS
+#define AW_PAT_TICK_MS 10
+#endif
+
+// Effects one AW20216SOffload tracks (bit i of the fallback mask = effect i).
+#define AW_OFFLOAD_MAX_EFFECTS 16
+
+// One periodic effect. Brightness rises over rampPct of the period, holds
+// maxV for dutyPct, falls over rampPct and rests at minV for the remainder.
+struct AwBreathEffect
+{
+    uint16_t periodMs;       // One full cycle
+    uint8_t dutyPct;         // Share of the period held at maxV (T1), 0-100
+    uint8_t rampPct;         // Share of the rise (T0) and of the fall (T2)
+    uint8_t minV;            // Brightness at rest, 0-255
+    uint8_t maxV;            // Brightness at the top, 0-255
+    uint8_t group;           // Phase group: start together (see startGroup())
+    bool logarithmic;        // Logarithmic ramps instead of linear
+    const uint8_t *rowMasks; // One byte per row, bit x = column x; nullptr = all
+    uint8_t channels;        // Channels driven: AW_CH_MASK() bits, AW_CH_RGB
+};
+
+// Where an effect ended up after apply().
+enum class AwOffloadStatus : uint8_t {
+    Engine   = 0, // Runs on a breathing engine
+    NoEngine = 1, // The three engines hold other programs: drive it with show()
+    Range    = 2  // Timing not representable (a phase over 255 steps, duty +
+                  // 2 x ramp over 100 %, or a zero period): drive it with show()
+};
+
+//* AW20216SOffload Class Definition */
+
+class AW20216SOffload
+{
+public:
+    /**
+     * @brief Offload effects onto one panel's breathing engines.
+     *
+     * @param driver Panel whose engines and Page 3 are programmed.
+     */
+    explicit AW20216SOffload(AW20216SBase &driver);
+
+    /**
+     * @brief Allocate engines, program them and bind the channels.
+     *
+     * Effects with the same timing, envelope, ramp shape and group share an
+     * engine; each new program takes the next free one, in list order. Each
+     * used engine costs one setupBreathing() burst, then all channel
+     * bindings go out in one commitPatterns() burst. Channels of effects
+     * that are not offloaded are bound to PWM so show() drives them. Later
+     * effects win where two select the same channel.
+     *
+     * @param effects Effect list.
+     * @param count   Number of effects (at most AW_OFFLOAD_MAX_EFFECTS).
+     * @return Fallback mask: bit i set if effect i must be drawn by the MCU.
+     * @note Engines are programmed but not started: call start().
+     */
+    uint16_t apply(const AwBreathEffect *effects, uint8_t count);
+
+    /**
+     * @brief Start every engine used by the last apply() in one PATGO write,
+     *        so all groups run in phase.
+     */
+    void start();
+
+    /**
+     * @brief Start only the engines of one phase group (e.g. to stagger
+     *        groups by a delay chosen by the sketch).
+     *
+     * @param group Phase group as given in AwBreathEffect::group.
+     */
+    void startGroup(uint8_t group);
+
+    /** @brief Engine running effect i, or PWM if it was not offloaded. */
+    AwPattern engine(uint8_t effect) const;
+
+    /** @brief Outcome of effect i in the last apply(). */
+    AwOffloadStatus status(uint8_t effect) const;
+
+    /** @brief Bit i set if effect i must be drawn by the MCU. */
+    inline uint16_t fallbackMask() const { return _fallback; }
+
+    /** @brief Number of breathing engines in use, 0-3. */
+    uint8_t enginesUsed() const;
+
+    /**
+     * @brief Convert an effect's timing to T0-T3 timer steps.
+     *
+     * @param e Effect.
+     * @param t Receives rise, on, fall and off steps (AW_PAT_TICK_MS each).
+     * @return false if the timing is not representable (AwOffloadStatus::Range).
+     */
+    static bool timerCodes(const AwBreathEffect &e, uint8_t t[4]);
+
+    /**
+     * @brief Brightness of an effect at a time, for MCU fallback.
+     *
+     * Follows the same rise / hold / fall / rest shape as an engine (the
+     * logarithmic ramp is approximated by a square curve).
+     *
+     * @param e  Effect.
+     * @param ms Milliseconds since the effect's group was started.
+     * @return Brightness, minV - maxV.
+     */
+    static uint8_t level(const AwBreathEffect &e, uint32_t ms);
+
+private:
+    // Program loaded into one engine.
+    struct Program
+    {
+        uint8_t t[4];
+        uint8_t minV;
+        uint8_t maxV;
+        uint8_t group;
+        bool logarithmic;
+    };
+
+    AW20216SBase *_driver;
+    uint8_t _count;                               // Effects in the last apply()
+    uint8_t _engines;                             // Engines holding a program
+    Program _programs[3];                         // Per engine, PAT0..PAT2
+    uint8_t _engineOf[AW_OFFLOAD_MAX_EFFECTS];    // Engine index, or 0xFF
+    AwOffloadStatus _status[AW_OFFLOAD_MAX_EFFECTS];
+    uint16_t _fallback;
+
+    /**
+     * @brief Engine index holding p, a newly allocated one, or 0xFF.
+     */
+    uint8_t _allocate(const Program &p);
+
+    /**
+     * @brief PATGO bits of the engines whose group matches (all if any).
+     */
+    uint8_t _startBits(bool any, uint8_t group) const;
+};
+
+#endif // AW20216S_OFFLOAD_H
@@ -0,0 +1,264 @@
+#include "AW20216SStream.h"
+#include "AW20216SColorLut.h" // aw_lut_detail::MakeSeq for the CRC table
+
+// CRC-8 (poly 0x07, same as the calibration blobs), one table read per byte
+// instead of eight shift/xor steps: the receiver sees up to ~90 KB/s.
+namespace aw_stream_detail
+{
+constexpr uint8_t crcShift(uint8_t c, uint8_t n)
+{
+    return n == 0 ? c : crcShift((c & 0x80u) ? (uint8_t)((c << 1) ^ 0x07u) : (uint8_t)(c << 1), (uint8_t)(n - 1u));
+}
+
+template <class S>
+struct CrcTable;
+
+template <uint16_t... I>
+struct CrcTable<aw_lut_detail::Seq<I...>>
+{
+    static const uint8_t table[sizeof...(I)];
+};
+
+template <uint16_t... I>
+const uint8_t CrcTable<aw_lut_detail::Seq<I...>>::table[sizeof...(I)] PROGMEM = {
+    crcShift((uint8_t)I, 8)...};
+
+typedef CrcTable<aw_lut_detail::MakeSeq<256>::type> Crc8;
+
+static_assert(crcShift(1, 8) == 0x07 && crcShift(0x80, 8) == 0x89, "stream CRC table");
+} // namespace aw_stream_detail
+
+//******************************************************** */
+
+/**
+ * @brief Bind the receiver to its drivers; every chip waits for a full frame.
+ *
+ * @param chips Driver pointers, indexed by the chip byte of a packet.
+ * @param count Number of drivers (clamped to AW_STREAM_MAX_CHIPS).
+ */
+AW20216SStream::AW20216SStream(AW20216SBase *const *chips, uint8_t count)
+{
+    _chips = chips;
+    _count = (count > AW_STREAM_MAX_CHIPS) ? AW_STREAM_MAX_CHIPS : count;
+    _shown = 0;
+    _errors = 0;
+    reset();
+}
+
+/**
+ * @brief Forget the partial packet and require full frames.
+ */
+void AW20216SStream::reset()
+{
+    _cobsLeft = 0;
+    _cobsZero = false;
+    _seq = 0;
+    _needKey = (uint16_t)((1UL << _count) - 1u);
+    _startPacket();
+}
+
+/**
+ * @brief Clear the per-packet parser state.
+ */
+void AW20216SStream::_startPacket()
+{
+    _havePending = false;
+    _pending = 0;
+    _pos = 0;
+    _crc = 0;
+    _bad = false;
+    _type = 0;
+    _chip = nullptr;
+    _chipIndex = 0;
+    _skip = false;
+    _field = 0;
+    _at = 0;
+    _runLeft = 0;
+    _limit = 0;
+    _lo = 0xFF;
+    _hi = 0x00;
+}
+
+//******************************************************** */
+
+/**
+ * @brief Decode one COBS byte from the link.
+ *
+ * @param b Received byte.
+ * @return Event completed by this byte.
+ */
+AwStreamEvent AW20216SStream::feed(uint8_t b)
+{
+    if (b == 0)
+        return _endPacket();
+
+    if (_cobsLeft == 0)
+    {
+        // Code byte: the previous block (if any) ended with a zero.
+        if (_cobsZero)
+            _decoded(0);
+        _cobsLeft = (uint8_t)(b - 1u);
+        _cobsZero = (b != 0xFFu);
+        return AwStreamEvent::None;
+    }
+
+    _cobsLeft--;
+    _decoded(b);
+    return AwStreamEvent::None;
+}
+
+/**
+ * @brief Hold back the newest decoded byte, parse the one before it.
+ *
+ * @param v Decoded byte.
+ */
+void AW20216SStream::_decoded(uint8_t v)
+{
+    if (_havePending)
+        _parse(_pending);
+    _pending = v;
+    _havePending = true;
+}
+
+/**
+ * @brief Advance the packet parser by one byte.
+ *
+ * @param v Packet byte (never the CRC).
+ */
+void AW20216SStream::_parse(uint8_t v)
+{
+    _crc = pgm_read_byte(&aw_stream_detail::Crc8::table[_crc ^ v]);
+    const uint16_t pos = _pos;
+    if (_pos != 0xFFFFu)
+        _pos++;
+
+    if (_bad)
+        return;
+
+    if (pos == 0)
+    {
+        _type = v;
+        if (v != AW_STREAM_FULL && v != AW_STREAM_DELTA && v != AW_STREAM_SHOW)
+            _bad = true;
+        return;
+    }
+    if (pos == 1)
+    {
+        _seq = v;
+        return;
+    }
+    if (_type == AW_STREAM_SHOW)
+    {
+        _bad = true; // Show packets have no body
+        return;
+    }
+    if (pos == 2)
+    {
+        if (v >= _count)
+        {
+            _bad = true;
+            return;
+        }
+        _chipIndex = v;
+        _chip = _chips[v];
+        _limit = (uint8_t)AW_BASE_Y(_chip->_rows);
+        _skip = (_type == AW_STREAM_DELTA) && (_needKey & (1u << v));
+        return;
+    }
+
+    if (_type == AW_STREAM_DELTA)
+    {
+        if (_field == 0)
+        {
+            _at = v;
+            _field = 1;
+            return;
+        }
+        if (_field == 1)
+        {
+            _runLeft = v;
+            if ((uint16_t)_at + v > _limit)
+                _bad = true;
+            else if (v != 0)
+                _field = 2;
+            else
+                _field = 0;
+            return;
+        }
+        if (--_runLeft == 0)
+            _field = 0;
+        if (_skip)
+        {
+            _at++;
+            return;
+        }
+    }
+    else if (_at >= _limit)
+    {
+        _bad = true; // Full frame longer than the panel
+        return;
+    }
+
+    // Pixel byte: straight into the drawing buffer.
+    _chip->_frameBuffer[_at] = v;
+    if (_at < _lo)
+        _lo = _at;
+    if (_at > _hi)
+        _hi = _at;
+    _at++;
+}
+
+/**
+ * @brief Close the packet at a 0x00 delimiter.
+ *
+ * @return Shown / Rejected for a valid show packet, else None.
+ */
+AwStreamEvent AW20216SStream::_endPacket()
+{
+    AwStreamEvent event = AwStreamEvent::None;
+
+    if (_pos == 0 && !_havePending && _cobsLeft == 0)
+    {
+        _cobsZero = false;
+        return event; // Empty packet: idle or resync delimiter
+    }
+
+    bool ok = !_bad && _cobsLeft == 0 && _havePending && _pos >= 2 && _pending == _crc;
+    if (ok && _type == AW_STREAM_FULL)
+        ok = (_chip != nullptr && _at == _limit);
+    else if (ok && _type == AW_STREAM_DELTA)
+        ok = (_chip != nullptr && _field == 0);
+
+    if (_lo <= _hi)
+        _chip->_markDirty(_lo, _hi);
+
+    if (!ok)
+    {
+        // Pixels may already be half-written: resync every chip.
+        _errors++;
+        _needKey = (uint16_t)((1UL << _count) - 1u);
+    }
+    else if (_type == AW_STREAM_FULL)
+    {
+        _needKey &= (uint16_t)~(1u << _chipIndex);
+    }
+    else if (_type == AW_STREAM_SHOW)
+    {
+        if (_needKey == 0)
+        {
+            for (uint8_t i = 0; i < _count; i++)
+                _chips[i]->show();
+            _shown++;
+            event = AwStreamEvent::Shown;
+        }
+        else
+        {
+            event = AwStreamEvent::Rejected;
+        }
+    }
+
+    _cobsLeft = 0;
+    _cobsZero = false;
+    _startPacket(); // _seq is kept for the reply
+    return event;
+}
@@ -0,0 +1,162 @@
+#ifndef AW20216S_STREAM_H
+#define AW20216S_STREAM_H
+
+#include "AW20216S.h"
+
+/**
+ * Live frame streaming over a serial link.
+ *
+ * AW20216SStream decodes a framed binary protocol byte by byte and writes
+ * the pixel bytes straight into the framebuffers of one or more drivers,
+ * with no packet buffer. A host tool (extras/stream) sends full or delta
+ * frames per chip, then a "show" packet; the receiver flushes every chip
+ * and answers ACK, or NAK when it has to be resynchronized.
+ *
+ * Wire format: every packet is COBS-encoded and terminated by a 0x00 byte.
+ * Decoded, a packet is
+ *
+ *   type, seq, body..., crc8        (CRC-8, poly 0x07, over type..body)
+ *
+ *   AW_STREAM_FULL   body = chip, AW_FRAME_SIZE(rows) PWM bytes
+ *   AW_STREAM_DELTA  body = chip, runs of { start, len, len PWM bytes }
+ *   AW_STREAM_SHOW   body = (none): show() every chip, then reply
+ *
+ * Replies are two raw bytes: AW_STREAM_ACK or AW_STREAM_NAK, then the seq
+ * of the show packet. After a bad packet the receiver ignores deltas and
+ * NAKs every show until each chip got a full frame.
+ */
+
+// Packet types.
+#define AW_STREAM_FULL  0x01
+#define AW_STREAM_DELTA 0x02
+#define AW_STREAM_SHOW  0x03
+
+// Reply codes (ASCII ACK / NAK).
+#define AW_STREAM_ACK 0x06
+#define AW_STREAM_NAK 0x15
+
+// Chips one receiver can address (one bit each in the keyframe mask).
+#define AW_STREAM_MAX_CHIPS 16
+
+// What a byte fed to the receiver completed.
+enum class AwStreamEvent : uint8_t {
+    None     = 0, // Nothing to report
+    Shown    = 1, // A show packet was applied: reply AW_STREAM_ACK
+    Rejected = 2  // A show packet arrived while out of sync: reply AW_STREAM_NAK
+};
+
+//* AW20216SStream Class Definition */
+
+class AW20216SStream
+{
+public:
+    /**
+     * @brief Receive frames for a set of drivers.
+     *
+     * @param chips Drivers, addressed by their index in this array (the
+     *              array and the drivers must outlive the receiver).
+     * @param count Number of drivers, at most AW_STREAM_MAX_CHIPS.
+     */
+    AW20216SStream(AW20216SBase *const *chips, uint8_t count);
+
+    /**
+     * @brief Decode one received byte.
+     *
+     * Pixel bytes go straight into the addressed framebuffer (one byte
+     * behind the input, since the last byte of a packet is its CRC).
+     *
+     * @param b Byte from the link.
+     * @return Shown / Rejected when a show packet completes, else None.
+     */
+    AwStreamEvent feed(uint8_t b);
+
+    /**
+     * @brief Call from loop(): decode what the link has buffered and reply.
+     *
+     * @param io Serial-like object (available(), read(), write(buf, len)).
+     * @return Number of frames shown.
+     */
+    template <class Io>
+    uint8_t poll(Io &io)
+    {
+        uint8_t shown = 0;
+        for (int n = io.available(); n > 0; n--)
+        {
+            const AwStreamEvent e = feed((uint8_t)io.read());
+            if (e == AwStreamEvent::None)
+                continue;
+
+            const uint8_t reply[2] = {(uint8_t)(e == AwStreamEvent::Shown ? AW_STREAM_ACK : AW_STREAM_NAK),
+                                      _seq};
+            io.write(reply, sizeof(reply));
+            if (e == AwStreamEvent::Shown)
+                shown++;
+        }
+        return shown;
+    }
+
+    /**
+     * @brief Drop any partial packet and wait for full frames again.
+     */
+    void reset();
+
+    /** @brief Frames shown since construction. */
+    inline uint32_t framesShown() const { return _shown; }
+
+    /** @brief Packets dropped (bad CRC, malformed, unknown chip) so far. */
+    inline uint32_t errors() const { return _errors; }
+
+    /** @brief Bit i set while chip i waits for a full frame. */
+    inline uint16_t keyframeMask() const { return _needKey; }
+
+private:
+    AW20216SBase *const *_chips;
+    uint8_t _count;
+
+    // COBS decoder
+    uint8_t _cobsLeft; // Data bytes left in the current block
+    bool _cobsZero;    // The current block ends with an implied zero
+
+    // Packet parser (one byte behind the decoder, see feed())
+    bool _havePending;
+    uint8_t _pending;  // Last decoded byte: data, or the CRC at the end
+    uint16_t _pos;     // Bytes parsed in this packet
+    uint8_t _crc;
+    bool _bad;         // Packet already known to be invalid
+    uint8_t _type;
+    uint8_t _seq;
+    AW20216SBase *_chip; // Addressed driver (FULL / DELTA), or nullptr
+    uint8_t _chipIndex;
+    bool _skip;          // Delta for a chip waiting for a full frame
+    uint8_t _field;      // Delta run field: 0 start, 1 len, 2 data
+    uint8_t _at;         // Next framebuffer index written
+    uint8_t _runLeft;    // Data bytes left in the delta run
+    uint8_t _limit;      // Framebuffer bytes of the addressed chip
+    uint8_t _lo, _hi;    // Bytes written by this packet (lo > hi: none)
+
+    uint16_t _needKey;
+    uint32_t _shown;
+    uint32_t _errors;
+
+    /**
+     * @brief Feed one decoded byte (a data byte, or the CRC if it is the last).
+     */
+    void _decoded(uint8_t v);
+
+    /**
+     * @brief Parse one packet byte known not to be the CRC.
+     */
+    void _parse(uint8_t v);
+
+    /**
+     * @brief Packet delimiter: check the CRC, apply the packet.
+     */
+    AwStreamEvent _endPacket();
+
+    /**
+     * @brief Clear the per-packet state.
+     */
+    void _startPacket();
+};
+
+#endif // AW20216S_STREAM_H
@@ -0,0 +1,308 @@
+#ifndef AW20216S_T_H
+#define AW20216S_T_H
+
+#include "AW20216S.h"
+
+/**
+ * AW20216S driver with the panel geometry fixed at compile time.
+ *
+ * Rows, columns and the mounting orientation are template parameters. The
+ * per-pixel calls map logical (x, y) to a register index with constant
+ * arithmetic (no runtime rows/cols multiply, no rotation switch), and the
+ * driver only reserves storage for Rows rows: a 6-row panel keeps two
+ * 108-byte frames instead of two 216-byte ones. Columns do not shrink the
+ * storage, since each row always spans the chip's 18 PWM registers.
+ *
+ * Coordinates are logical: as seen on the mounted panel, width() x height()
+ * after the rotation, with the same rotation/mirror convention as
+ * AW20216SArray::addPanel().
+ */
+
+//* AW20216ST Class Definition */
+
+/**
+ * @brief Driver for a Rows x Cols panel mounted with a fixed orientation.
+ *
+ * @tparam Rows     SW lines wired to the matrix, 1-12.
+ * @tparam Cols     RGB triplets per row, 1-6.
+ * @tparam Rotation Clockwise rotation of the panel as mounted.
+ * @tparam MirrorX  Panel columns run right-to-left (applied before the
+ *                  rotation).
+ *
+ * setPixel(), fillRect(), drawHLine(), drawVLine(), the blits, scroll(),
+ * setPixelScaling() and the per-pixel pattern calls take logical
+ * coordinates. setPatternMask(), the viewport, the indexed frame and raw
+ * register access keep addressing the chip's own rows and columns.
+ *
+ * @code
+ * AW20216ST<6, 6> small(CS_PIN);                        // 6x6, upright
+ * AW20216ST<12, 6, AwRotation::R90> sideways(CS_PIN);  // seen as 12 x 6
+ * @endcode
+ */
+template <uint8_t Rows, uint8_t Cols, AwRotation Rotation = AwRotation::R0, bool MirrorX = false>
+class AW20216ST : public AW20216SBase
+{
+    static_assert(Rows >= 1 && Rows <= AW_MAX_ROWS, "AW20216ST: Rows must be 1-12");
+    static_assert(Cols >= 1 && Cols <= 6, "AW20216ST: Cols must be 1-6");
+
+public:
+    static constexpr bool Sideways = (Rotation == AwRotation::R90 || Rotation == AwRotation::R270);
+    static constexpr uint8_t Width = Sideways ? Rows : Cols;  // Logical width
+    static constexpr uint8_t Height = Sideways ? Cols : Rows; // Logical height
+
+    /**
+     * @brief Construct the driver. Call begin() before any other method.
+     *
+     * @param csPin   MCU GPIO used as Chip Select (active LOW).
+     * @param spiPort SPI bus instance driving the chip.
+     */
+    explicit AW20216ST(uint8_t csPin, SPIClass &spiPort = SPI)
+        : AW20216SBase(Rows, Cols, csPin, spiPort, _storage, Rows) {}
+
+    /** @brief Logical width in pixels. */
+    static constexpr uint8_t width() { return Width; }
+
+    /** @brief Logical height in pixels. */
+    static constexpr uint8_t height() { return Height; }
+
+    /**
+     * @brief Framebuffer / PWM register index of the R channel of logical
+     *        pixel (x, y). No bounds check.
+     */
+    static constexpr uint8_t index(uint8_t x, uint8_t y)
+    {
+        return AW_BASE_INDEX(_col(x, y), _row(x, y));
+    }
+
+    /**
+     * @brief Write one RGB pixel. Out-of-range coordinates are ignored.
+     * @note RAM-only operation. Call show() to apply.
+     */
+    inline void setPixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b)
+    {
+        if (x >= Width || y >= Height)
+            return;
+        _setPixelAt(index(x, y), r, g, b);
+    }
+
+    /**
+     * @brief Fill a clipped rectangle (logical coordinates).
+     * @note RAM-only operation. Call show() to apply.
+     */
+    void fillRect(int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t r, uint8_t g, uint8_t b)
+    {
+        if (w == 0 || h == 0 || x >= Width || y >= Height || x + w <= 0 || y + h <= 0)
+            return;
+
+        // The orientation is an axis-aligned affine map: the rectangle stays
+        // a rectangle, spanned by its two mapped corners.
+        const int16_t c0 = _col(x, y), c1 = _col(x + w - 1, y + h - 1);
+        const int16_t r0 = _row(x, y), r1 = _row(x + w - 1, y + h - 1);
+        AW20216SBase::fillRect(c0 < c1 ? c0 : c1, r0 < r1 ? r0 : r1,
+                               Sideways ? h : w, Sideways ? w : h, r, g, b);
+    }
+
+    /** @brief Horizontal line of w pixels (logical coordinates). */
+    inline void drawHLine(int16_t x, int16_t y, uint8_t w, uint8_t r, uint8_t g, uint8_t b)
+    {
+        fillRect(x, y, w, 1, r, g, b);
+    }
+
+    /** @brief Vertical line of h pixels (logical coordinates). */
+    inline void drawVLine(int16_t x, int16_t y, uint8_t h, uint8_t r, uint8_t g, uint8_t b)
+    {
+        fillRect(x, y, 1, h, r, g, b);
+    }
+
+    /** @brief Copy a w x h RGB image from RAM (logical coordinates). */
+    inline void blitRGB(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *rgb)
+    {
+        _blitRGB(x, y, w, h, rgb, false);
+    }
+
+    /** @brief Copy a w x h RGB image from PROGMEM (logical coordinates). */
+    inline void blitRGB_P(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *rgb)
+    {
+        _blitRGB(x, y, w, h, rgb, true);
+    }
+
+    /** @brief Draw the set bits of a 1-bit bitmap from RAM in one color. */
+    inline void blit1bpp(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bits,
+                         uint8_t r, uint8_t g, uint8_t b)
+    {
+        _blit1bpp(x, y, w, h, bits, r, g, b, false);
+    }
+
+    /** @brief Draw the set bits of a 1-bit bitmap from PROGMEM in one color. */
+    inline void blit1bpp_P(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bits,
+                           uint8_t r, uint8_t g, uint8_t b)
+    {
+        _blit1bpp(x, y, w, h, bits, r, g, b, true);
+    }
+
+    /**
+     * @brief Shift the picture by (dx, dy) logical pixels, filling the
+     *        uncovered edge with (r, g, b).
+     */
+    inline void scroll(int8_t dx, int8_t dy, uint8_t r = 0, uint8_t g = 0, uint8_t b = 0)
+    {
+        AW20216SBase::scroll((int8_t)(_col(dx, dy) - _col(0, 0)),
+                             (int8_t)(_row(dx, dy) - _row(0, 0)), r, g, b);
+    }
+
+#if AW_ENABLE_SCALING_BUFFER
+    /**
+     * @brief Store one pixel's scaling (RAM only, see showScaling()).
+     */
+    inline void setPixelScaling(uint8_t x, uint8_t y, uint8_t r_scale, uint8_t g_scale, uint8_t b_scale)
+    {
+        if (x >= Width || y >= Height)
+            return;
+        _setScalingAt(index(x, y), r_scale, g_scale, b_scale);
+    }
+
+    /**
+     * @brief Set one pixel at 16 bits per channel (see AW20216SBase).
+     */
+    inline void setPixel16(uint8_t x, uint8_t y, uint16_t r, uint16_t g, uint16_t b)
+    {
+        if (x >= Width || y >= Height)
+            return;
+        _setPixel16At(index(x, y), r, g, b);
+    }
+#endif
+
+    /**
+     * @brief Bind one channel of a pixel to a breathing pattern (Page 3).
+     */
+    inline void setChannelPattern(uint8_t x, uint8_t y, AwChannel ch, AwPattern pat)
+    {
+        if (x >= Width || y >= Height)
+            return;
+        _setChannelPatternAt((uint8_t)(index(x, y) + (uint8_t)ch), pat);
+    }
+
+    /**
+     * @brief Bind the R, G and B channels of a pixel to breathing patterns.
+     */
+    inline void setPixelPatternRGB(uint8_t x, uint8_t y, AwPattern rPat, AwPattern gPat, AwPattern bPat)
+    {
+        if (x >= Width || y >= Height)
+            return;
+        _setPixelPatternAt(index(x, y), rPat, gPat, bPat);
+    }
+
+    /**
+     * @brief Bind a (clipped) logical rectangle to breathing patterns
+     *        (RAM only, see commitPatterns()).
+     */
+    void setPatternRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+                        AwPattern rPat, AwPattern gPat, AwPattern bPat)
+    {
+        if (w == 0 || h == 0 || x >= Width || y >= Height)
+            return;
+
+        const uint8_t x1 = (w > (uint8_t)(Width - x)) ? (uint8_t)(Width - 1u) : (uint8_t)(x + w - 1u);
+        const uint8_t y1 = (h > (uint8_t)(Height - y)) ? (uint8_t)(Height - 1u) : (uint8_t)(y + h - 1u);
+        const int16_t c0 = _col(x, y), c1 = _col(x1, y1);
+        const int16_t r0 = _row(x, y), r1 = _row(x1, y1);
+        AW20216SBase::setPatternRect((uint8_t)(c0 < c1 ? c0 : c1), (uint8_t)(r0 < r1 ? r0 : r1),
+                                     (uint8_t)((c0 < c1 ? c1 - c0 : c0 - c1) + 1),
+                                     (uint8_t)((r0 < r1 ? r1 - r0 : r0 - r1) + 1),
+                                     rPat, gPat, bPat);
+    }
+
+private:
+    static constexpr bool Upright = (Rotation == AwRotation::R0 && !MirrorX);
+
+    uint8_t _storage[AW_DRIVER_RAM(Rows)];
+
+    // Chip column of logical (x, y), before the mirror.
+    static constexpr int16_t _colUnmirrored(int16_t x, int16_t y)
+    {
+        return Rotation == AwRotation::R90    ? y
+               : Rotation == AwRotation::R180 ? (int16_t)(Cols - 1 - x)
+               : Rotation == AwRotation::R270 ? (int16_t)(Cols - 1 - y)
+                                              : x;
+    }
+
+    // Chip column / row of logical (x, y). Affine, so also valid (and used)
+    // for off-panel points and for deltas.
+    static constexpr int16_t _col(int16_t x, int16_t y)
+    {
+        return MirrorX ? (int16_t)(Cols - 1 - _colUnmirrored(x, y)) : _colUnmirrored(x, y);
+    }
+
+    static constexpr int16_t _row(int16_t x, int16_t y)
+    {
+        return Rotation == AwRotation::R90    ? (int16_t)(Rows - 1 - x)
+               : Rotation == AwRotation::R180 ? (int16_t)(Rows - 1 - y)
+               : Rotation == AwRotation::R270 ? x
+                                              : y;
+    }
+
+    void _blitRGB(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *rgb, bool progmem)
+    {
+        if (Upright)
+        {
+            // Same layout as the chip: the row-wise copies of the base class.
+            if (progmem)
+                AW20216SBase::blitRGB_P(x, y, w, h, rgb);
+            else
+                AW20216SBase::blitRGB(x, y, w, h, rgb);
+            return;
+        }
+
+        for (uint8_t sy = 0; sy < h; sy++)
+        {
+            const int16_t py = y + sy;
+            if (py < 0 || py >= Height)
+                continue;
+            for (uint8_t sx = 0; sx < w; sx++)
+            {
+                const int16_t px = x + sx;
+                if (px < 0 || px >= Width)
+                    continue;
+                const uint8_t *src = &rgb[((uint16_t)sy * w + sx) * 3u];
+                if (progmem)
+                    _setPixelAt(index((uint8_t)px, (uint8_t)py), pgm_read_byte(&src[0]),
+                                pgm_read_byte(&src[1]), pgm_read_byte(&src[2]));
+                else
+                    _setPixelAt(index((uint8_t)px, (uint8_t)py), src[0], src[1], src[2]);
+            }
+        }
+    }
+
+    void _blit1bpp(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bits,
+                   uint8_t r, uint8_t g, uint8_t b, bool progmem)
+    {
+        if (Upright)
+        {
+            if (progmem)
+                AW20216SBase::blit1bpp_P(x, y, w, h, bits, r, g, b);
+            else
+                AW20216SBase::blit1bpp(x, y, w, h, bits, r, g, b);
+            return;
+        }
+
+        const uint8_t stride = (uint8_t)((w + 7u) / 8u);
+        for (uint8_t sy = 0; sy < h; sy++)
+        {
+            const int16_t py = y + sy;
+            if (py < 0 || py >= Height)
+                continue;
+            for (uint8_t sx = 0; sx < w; sx++)
+            {
+                const int16_t px = x + sx;
+                if (px < 0 || px >= Width)
+                    continue;
+                const uint8_t *p = &bits[(uint16_t)sy * stride + (sx >> 3)];
+                const uint8_t byte = progmem ? pgm_read_byte(p) : *p;
+                if (byte & (uint8_t)(0x80u >> (sx & 7u)))
+                    _setPixelAt(index((uint8_t)px, (uint8_t)py), r, g, b);
+            }
+        }
+    }
+};
+
+#endif // AW20216S_T_H
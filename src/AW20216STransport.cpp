@@ -0,0 +1,178 @@
+#include "AW20216STransport.h"
+
+//******************************************************** */
+
+/**
+ * @brief Point the pin at a sink so an early high() / low() is harmless.
+ */
+AwFastPin::AwFastPin()
+{
+#if AW_FAST_GPIO && defined(ARDUINO_ARCH_AVR)
+    static uint8_t sink;
+    _out = &sink;
+    _in = &sink;
+    _mask = 0;
+#elif AW_FAST_GPIO
+    static uint32_t sink;
+    _set = &sink;
+    _clr = &sink;
+    _in = &sink;
+    _mask = 0;
+#else
+    _pin = AW_NO_PIN;
+#endif
+}
+
+/**
+ * @brief Configure the pin and look up its port registers.
+ *
+ * @param pin  Arduino pin number.
+ * @param mode OUTPUT or INPUT.
+ */
+void AwFastPin::begin(uint8_t pin, uint8_t mode)
+{
+    pinMode(pin, mode);
+
+#if AW_FAST_GPIO && defined(ARDUINO_ARCH_AVR)
+    const uint8_t port = digitalPinToPort(pin);
+    _out = portOutputRegister(port);
+    _in = portInputRegister(port);
+    _mask = digitalPinToBitMask(pin);
+#elif AW_FAST_GPIO && defined(ARDUINO_ARCH_SAMD)
+    PortGroup *group = &PORT->Group[g_APinDescription[pin].ulPort];
+    _set = &group->OUTSET.reg;
+    _clr = &group->OUTCLR.reg;
+    _in = &group->IN.reg;
+    _mask = 1ul << g_APinDescription[pin].ulPin;
+#elif AW_FAST_GPIO && defined(ARDUINO_ARCH_ESP32)
+#ifdef GPIO_OUT1_W1TS_REG
+    if (pin >= 32)
+    {
+        _set = (volatile uint32_t *)GPIO_OUT1_W1TS_REG;
+        _clr = (volatile uint32_t *)GPIO_OUT1_W1TC_REG;
+        _in = (volatile uint32_t *)GPIO_IN1_REG;
+        _mask = 1ul << (pin - 32u);
+        return;
+    }
+#endif
+    _set = (volatile uint32_t *)GPIO_OUT_W1TS_REG;
+    _clr = (volatile uint32_t *)GPIO_OUT_W1TC_REG;
+    _in = (volatile uint32_t *)GPIO_IN_REG;
+    _mask = 1ul << pin;
+#else
+    _pin = pin;
+#endif
+}
+
+//******************************************************** */
+
+/**
+ * @brief Configure the pins: CS high, SCK idle low (mode 0).
+ */
+void AwSoftSpiTransport::begin()
+{
+    _cs.begin(_csPin, OUTPUT);
+    _cs.high();
+    _sck.begin(_sckPin, OUTPUT);
+    _sck.low();
+    _mosi.begin(_mosiPin, OUTPUT);
+    if (_misoPin != AW_NO_PIN)
+        _miso.begin(_misoPin, INPUT);
+}
+
+/**
+ * @brief Shift one byte, MSB first: data set while SCK is low, sampled on
+ *        the rising edge.
+ *
+ * @param b Byte to send.
+ * @return Byte read on MISO (0 without a MISO pin).
+ */
+uint8_t AwSoftSpiTransport::transfer(uint8_t b)
+{
+    uint8_t in = 0;
+    for (uint8_t bit = 0x80; bit; bit >>= 1)
+    {
+        _mosi.write((b & bit) != 0);
+#if AW_SOFT_SPI_DELAY_US
+        delayMicroseconds(AW_SOFT_SPI_DELAY_US);
+#endif
+        _sck.high();
+        if (_misoPin != AW_NO_PIN && _miso.read())
+            in |= bit;
+#if AW_SOFT_SPI_DELAY_US
+        delayMicroseconds(AW_SOFT_SPI_DELAY_US);
+#endif
+        _sck.low();
+    }
+    return in;
+}
+
+/**
+ * @brief Send bytes without sampling MISO.
+ *
+ * @param data Bytes to send.
+ * @param len  Number of bytes.
+ */
+void AwSoftSpiTransport::write(const uint8_t *data, uint16_t len)
+{
+    while (len--)
+    {
+        const uint8_t b = *data++;
+        for (uint8_t bit = 0x80; bit; bit >>= 1)
+        {
+            _mosi.write((b & bit) != 0);
+#if AW_SOFT_SPI_DELAY_US
+            delayMicroseconds(AW_SOFT_SPI_DELAY_US);
+#endif
+            _sck.high();
+#if AW_SOFT_SPI_DELAY_US
+            delayMicroseconds(AW_SOFT_SPI_DELAY_US);
+#endif
+            _sck.low();
+        }
+    }
+}
+
+//******************************************************** */
+
+/**
+ * @brief Log one byte and answer the configured read value.
+ *
+ * @param b Byte sent.
+ * @return setReadValue() value.
+ */
+uint8_t AwRecorderTransport::transfer(uint8_t b)
+{
+    if (_len < _size)
+        _buf[_len++] = b;
+    else
+        _overflow++;
+    return _readValue;
+}
+
+/**
+ * @brief Log a burst.
+ *
+ * @param data Bytes sent.
+ * @param len  Number of bytes.
+ */
+void AwRecorderTransport::write(const uint8_t *data, uint16_t len)
+{
+    uint16_t n = (uint16_t)(_size - _len);
+    if (n > len)
+        n = len;
+    memcpy(_buf + _len, data, n);
+    _len = (uint16_t)(_len + n);
+    _overflow += (uint32_t)(len - n);
+}
+
+/**
+ * @brief Empty the log and zero the counters.
+ */
+void AwRecorderTransport::clear()
+{
+    _len = 0;
+    _overflow = 0;
+    _frames = 0;
+    _transactions = 0;
+}
@@ -0,0 +1,265 @@
+#ifndef AW20216S_TRANSPORT_H
+#define AW20216S_TRANSPORT_H
+
+#include <Arduino.h>
+
+/**
+ * Bus access for the AW20216S driver.
+ *
+ * By default a driver talks to its chip through hardware SPI (SPIClass)
+ * and toggles chip select with AwFastPin, a direct port-register write on
+ * AVR, SAMD and ESP32. setTransport() swaps the whole bus for an
+ * AwTransport: AwSoftSpiTransport bit-bangs any four pins,
+ * AwRecorderTransport logs the bytes to RAM for tests, and sketches can
+ * derive their own (an SPI bus behind a mux, a USB bridge, ...).
+ */
+
+// Direct port-register GPIO for chip select and bit-banged SPI. Set to 0 to
+// fall back to digitalWrite() / digitalRead() (e.g. on an unusual variant).
+#ifndef AW_FAST_GPIO
+#if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_ESP32)
+#define AW_FAST_GPIO 1
+#else
+#define AW_FAST_GPIO 0
+#endif
+#endif
+
+#if AW_FAST_GPIO && defined(ARDUINO_ARCH_ESP32)
+#include <soc/gpio_reg.h>
+#endif
+
+// Extra delay per SCK half period of AwSoftSpiTransport, in microseconds.
+// 0 runs as fast as the GPIO allows (the chip accepts up to 10 MHz).
+#ifndef AW_SOFT_SPI_DELAY_US
+#define AW_SOFT_SPI_DELAY_US 0
+#endif
+
+// Unused pin (e.g. no MISO line for AwSoftSpiTransport).
+#define AW_NO_PIN 0xFF
+
+//******************************************************** */
+
+/**
+ * @brief One GPIO driven through its port registers.
+ *
+ * high() / low() cost a couple of cycles instead of the few microseconds of
+ * digitalWrite() on AVR. Writes are safe against interrupts (AVR) and the
+ * other core (ESP32 set/clear registers).
+ */
+class AwFastPin
+{
+public:
+    /**
+     * @brief Unbound pin: writes go to a dummy register until begin().
+     */
+    AwFastPin();
+
+    /**
+     * @brief Configure the pin and cache its registers.
+     *
+     * @param pin  Arduino pin number.
+     * @param mode OUTPUT or INPUT.
+     */
+    void begin(uint8_t pin, uint8_t mode);
+
+#if AW_FAST_GPIO && defined(ARDUINO_ARCH_AVR)
+    inline void high()
+    {
+        const uint8_t sreg = SREG;
+        cli();
+        *_out |= _mask;
+        SREG = sreg;
+    }
+    inline void low()
+    {
+        const uint8_t sreg = SREG;
+        cli();
+        *_out &= (uint8_t)~_mask;
+        SREG = sreg;
+    }
+    inline bool read() const { return (*_in & _mask) != 0; }
+#elif AW_FAST_GPIO
+    inline void high() { *_set = _mask; }
+    inline void low() { *_clr = _mask; }
+    inline bool read() const { return (*_in & _mask) != 0; }
+#else
+    inline void high() { digitalWrite(_pin, HIGH); }
+    inline void low() { digitalWrite(_pin, LOW); }
+    inline bool read() const { return digitalRead(_pin) != LOW; }
+#endif
+
+    /** @brief Drive the pin to a level. */
+    inline void write(bool level)
+    {
+        if (level)
+            high();
+        else
+            low();
+    }
+
+private:
+#if AW_FAST_GPIO && defined(ARDUINO_ARCH_AVR)
+    volatile uint8_t *_out;
+    volatile uint8_t *_in;
+    uint8_t _mask;
+#elif AW_FAST_GPIO
+    volatile uint32_t *_set; // Write-1-to-set
+    volatile uint32_t *_clr; // Write-1-to-clear
+    volatile uint32_t *_in;
+    uint32_t _mask;
+#else
+    uint8_t _pin;
+#endif
+};
+
+//******************************************************** */
+
+/**
+ * @brief Byte transport behind a driver (see AW20216SBase::setTransport()).
+ *
+ * The driver frames every command as select(), bytes, deselect(), inside
+ * beginTransaction() / endTransaction() (several frames may share one
+ * transaction). Only transfer() is required; write() and read() loop over
+ * it unless a transport has something faster.
+ */
+class AwTransport
+{
+public:
+    /** @brief Set up pins / peripherals, CS inactive; called from the driver's begin(). */
+    virtual void begin() {}
+
+    /** @brief Take the bus (e.g. SPI.beginTransaction()). */
+    virtual void beginTransaction() {}
+
+    /** @brief Release the bus. */
+    virtual void endTransaction() {}
+
+    /** @brief Chip select active (LOW). */
+    virtual void select() = 0;
+
+    /** @brief Chip select inactive (HIGH). */
+    virtual void deselect() = 0;
+
+    /**
+     * @brief Shift one byte out and one in.
+     *
+     * @param b Byte sent on MOSI.
+     * @return Byte received on MISO.
+     */
+    virtual uint8_t transfer(uint8_t b) = 0;
+
+    /**
+     * @brief Send bytes, ignoring MISO.
+     */
+    virtual void write(const uint8_t *data, uint16_t len)
+    {
+        while (len--)
+            transfer(*data++);
+    }
+
+    /**
+     * @brief Receive bytes, sending 0x00.
+     */
+    virtual void read(uint8_t *buf, uint16_t len)
+    {
+        while (len--)
+            *buf++ = transfer(0x00);
+    }
+
+protected:
+    ~AwTransport() {}
+};
+
+//* AwSoftSpiTransport Class Definition */
+
+/**
+ * @brief SPI mode 0, MSB first, bit-banged on any pins.
+ *
+ * For boards whose hardware SPI is taken (SD card, display on other
+ * settings) or routed to the wrong pins. Each chip gets its own transport;
+ * chips on one soft bus share SCK / MOSI / MISO and differ in cs.
+ *
+ * @code
+ * AwSoftSpiTransport softBus(6, 7, AW_NO_PIN, 8);   // sck, mosi, miso, cs
+ * ledMatrix.setTransport(&softBus);
+ * ledMatrix.begin();
+ * @endcode
+ */
+class AwSoftSpiTransport : public AwTransport
+{
+public:
+    /**
+     * @param sck  Clock pin.
+     * @param mosi Data to the chip.
+     * @param miso Data from the chip, or AW_NO_PIN (reads return 0: begin()
+     *             then reports false, everything else works).
+     * @param cs   Chip select, active LOW.
+     */
+    AwSoftSpiTransport(uint8_t sck, uint8_t mosi, uint8_t miso, uint8_t cs)
+        : _sckPin(sck), _mosiPin(mosi), _misoPin(miso), _csPin(cs) {}
+
+    void begin() override;
+    void select() override { _cs.low(); }
+    void deselect() override { _cs.high(); }
+    uint8_t transfer(uint8_t b) override;
+    void write(const uint8_t *data, uint16_t len) override;
+
+private:
+    uint8_t _sckPin, _mosiPin, _misoPin, _csPin;
+    AwFastPin _sck, _mosi, _miso, _cs;
+};
+
+//* AwRecorderTransport Class Definition */
+
+/**
+ * @brief Logs every byte the driver sends to a RAM buffer, no hardware.
+ *
+ * For unit tests on the board or the host: run driver calls, then compare
+ * data()[0 .. length()) with the expected frames. Reads answer
+ * setReadValue() (0 by default), so begin() reports false unless that
+ * value equals the GCR written.
+ */
+class AwRecorderTransport : public AwTransport
+{
+public:
+    /**
+     * @param buf  Log storage.
+     * @param size Bytes at buf; later bytes are counted in overflow().
+     */
+    AwRecorderTransport(uint8_t *buf, uint16_t size)
+        : _buf(buf), _size(size), _len(0), _overflow(0), _frames(0), _transactions(0),
+          _readValue(0) {}
+
+    void beginTransaction() override { _transactions++; }
+    void select() override {}
+    void deselect() override { _frames++; }
+    uint8_t transfer(uint8_t b) override;
+    void write(const uint8_t *data, uint16_t len) override;
+
+    /** @brief Empty the log and zero the counters. */
+    void clear();
+
+    /** @brief Byte returned for every byte read. */
+    inline void setReadValue(uint8_t v) { _readValue = v; }
+
+    inline const uint8_t *data() const { return _buf; }
+    /** @brief Bytes logged. */
+    inline uint16_t length() const { return _len; }
+    /** @brief Bytes that did not fit in the log. */
+    inline uint32_t overflow() const { return _overflow; }
+    /** @brief CS frames (select .. deselect). */
+    inline uint32_t frames() const { return _frames; }
+    /** @brief beginTransaction() calls. */
+    inline uint32_t transactions() const { return _transactions; }
+
+private:
+    uint8_t *_buf;
+    uint16_t _size;
+    uint16_t _len;
+    uint32_t _overflow;
+    uint32_t _frames;
+    uint32_t _transactions;
+    uint8_t _readValue;
+};
+
+#endif // AW20216S_TRANSPORT_H